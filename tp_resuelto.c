@@ -2,6 +2,10 @@
 #include <SDL2/SDL_image.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <limits.h>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
 #include <time.h>
 
 
@@ -20,6 +24,10 @@
 #define CELL_WIDTH (GRID_WIDTH / GRID_COLS)
 #define CELL_HEIGHT (GRID_HEIGHT / GRID_ROWS)
 
+// Las máscaras de filas activas (filas_con_plantas, etc.) son int con
+// un bit por fila: la fila 31 caería en el bit de signo.
+_Static_assert(GRID_ROWS <= 31, "las mascaras de filas son int: GRID_ROWS no puede pasar de 31");
+
 #define PEASHOOTER_FRAME_WIDTH 177
 #define PEASHOOTER_FRAME_HEIGHT 166
 #define PEASHOOTER_TOTAL_FRAMES 31
@@ -30,11 +38,39 @@
 #define ZOMBIE_FRAME_HEIGHT 203
 #define ZOMBIE_TOTAL_FRAMES 90
 #define ZOMBIE_ANIMATION_SPEED 2
-#define ZOMBIE_DISTANCE_PER_CYCLE 40.0f
+#define ZOMBIE_DISTANCE_PER_CYCLE 40
 
-#define MAX_ARVEJAS 100
+#define ARVEJAS_INICIALES 100 // capacidad inicial del array de arvejas (crece duplicando)
 #define PEA_SPEED 5
+#define PEA_SIZE 20 // ancho y alto de la arveja en pantalla
+#define PEA_DAMAGE 25 // vida que le saca una arveja a un zombie (tiene 100)
 #define ZOMBIE_SPAWN_RATE 300
+#define ZOMBIE_TIPO_NORMAL 0 // único tipo de zombie por ahora (ver gameBoardLoadWaves)
+#define OLEADA_ESPACIADO (CELL_WIDTH / 2) // separación por defecto entre zombies de una oleada
+#define ZOMBIE_BLOCK_SIZE 64 // nodos de zombie que se piden por malloc como mínimo
+#define PEASHOOTER_COOLDOWN 120 // ticks de espera después de cada disparo
+#define RUEDA_PLANTAS 256 // slots de la rueda de plantas (potencia de 2, ver programarPlanta)
+#define TRAMO_ZOMBIES 256  // zombies por trabajo al moverlos con hilos (ver paraleloPorTramos)
+#define TRAMO_ARVEJAS 1024 // arvejas por trabajo al moverlas con hilos
+#define COLA_COMANDOS 256  // lugares de la cola de comandos (potencia de 2, ver gameBoardPushCommand)
+
+// Comandos que el input le manda a la simulación (ver gameBoardPushCommand)
+#define COMANDO_PLANTAR 0
+#define COMANDO_SACAR_PLANTA 1
+#define COMANDO_ZOMBIE 2
+
+// Posiciones en punto fijo 16.16 (entero: 16 bits de parte entera y 16 de fracción).
+// Con enteros el movimiento es exacto y da igual en cualquier compilador o
+// nivel de optimización, así que dos corridas con la misma semilla son idénticas.
+#define FX_SHIFT 16
+#define FX_ONE (1 << FX_SHIFT)
+#define INT_TO_FX(x) ((x) * FX_ONE)
+#define FX_TO_INT(x) ((x) >> FX_SHIFT)
+#define FX_MAX_PX 32767 // mayor posición en píxeles que entra en un int 16.16
+
+// Velocidades por tick en 16.16
+#define ZOMBIE_SPEED_FX (INT_TO_FX(ZOMBIE_DISTANCE_PER_CYCLE) / (ZOMBIE_TOTAL_FRAMES * ZOMBIE_ANIMATION_SPEED))
+#define PEA_SPEED_FX INT_TO_FX(PEA_SPEED)
 
 
 // ========= ESTRUCTURAS DE DATOS =========
@@ -42,18 +78,29 @@ typedef struct {
     int row, col;
 } Cursor;
 
-typedef struct {
+typedef struct Planta {
     SDL_Rect rect;
     int activo;
-    int cooldown;
-    int current_frame;
-    int frame_timer;
+    int cooldown; // Ticks de espera hasta poder volver a disparar (los cuenta la rueda)
+    int fase;     // Tick en el que se plantó: su frame sale de board->tick (ver framePlanta)
     int debe_disparar;
+    int alcance; // Alcance de disparo en píxeles (0 = toda la fila)
+    int row;
+    int tick_rueda; // Tick en el que la rueda la vuelve a mirar (-1: espera zombies)
+    int esperando_rango; // 1: está en la rueda para cuando un zombie entre en su alcance
+    struct Planta* rueda_ant; // Enlaces de la lista del slot de la rueda en el que está
+    struct Planta* rueda_sig;
 } Planta;
 
+// Las arvejas viven compactas en board->arvejas[0, cant_arvejas): todas
+// las que están en el array están en vuelo, así que no hace falta 'activo'.
+// La posición y la fila, que es lo que se lee en cada tick, van aparte en
+// board->arvejas_x y board->arvejas_fila (mismo índice); el rectángulo
+// se arma solo cuando hace falta (ver rectDeArveja).
 typedef struct {
-    SDL_Rect rect;
-    int activo;
+    int pos_en_fila;  // Posición de su índice dentro del bucket de la fila
+    int tick_impacto; // Modo eventos: tick en el que hay que resolver su impacto
+    int pos_en_heap;  // Modo eventos: posición en la cola de impactos (-1 si no está)
 } Arveja;
 
 typedef struct {
@@ -61,9 +108,8 @@ typedef struct {
     int activo;
     int vida;
     int row;
-    int current_frame;
-    int frame_timer;
-    float pos_x;
+    int tick_spawn; // Tick en el que apareció: su frame sale de ahí (ver frameZombie)
+    int pos_x; // Posición en punto fijo 16.16 (rect.x es su parte entera)
 } Zombie;
 
 // ========= NUEVAS ESTRUCTURAS =========
@@ -80,18 +126,151 @@ typedef struct RowSegment {
 
 typedef struct ZombieNode {
     Zombie zombie_data;
+    struct ZombieNode* prev; // Doble enlace: permite desenganchar el nodo en O(1)
     struct ZombieNode* next;
+    int slot;                // Índice fijo del nodo en la tabla de slots del board
+    int pos_en_fila;         // Posición del nodo en el índice ordenado de su fila
+    unsigned int generation; // Aumenta cada vez que el nodo vuelve al pool
 } ZombieNode;
 
+// Referencia estable a un zombie (ver gameBoardGetZombieHandle).
+// Si el zombie murió, la generación ya no coincide y el handle queda vencido.
+typedef struct {
+    int index;
+    unsigned int generation;
+} ZombieHandle;
+
+// Un impacto de arveja detectado en la fase de colisiones (ver gameBoardGetHits).
+// 'arveja' es el índice en board->arvejas al momento del impacto: solo vale
+// durante ese tick, después la arveja ya no existe y otra ocupa su lugar.
+typedef struct {
+    int arveja;
+    int fila;
+    int x;               // Posición de la arveja al impactar (para efectos)
+    ZombieHandle zombie; // El zombie impactado (vencido si murió)
+    int dano;
+} Golpe;
+
+// Evento de la línea de tiempo de oleadas (ver gameBoardLoadWaves)
+typedef struct {
+    int tick;      // Tick del board en el que spawnea
+    int row;
+    int cantidad;
+    int tipo;
+    int espaciado; // Píxeles entre zombies de la misma oleada
+} EventoOleada;
+
+// Bloque de nodos de zombie pedido con un solo malloc (ver reservarZombies)
+typedef struct ZombieBlock {
+    struct ZombieBlock* next;
+    ZombieNode nodes[];
+} ZombieBlock;
+
 typedef struct GardenRow {
     RowSegment* first_segment;
     ZombieNode* first_zombie;
+    ZombieNode* front_zombie; // Zombie con menor pos_x de la fila (el último de la lista)
+    int zombies_activos;      // Zombies vivos en la fila (se mantiene al spawnear y al morir)
+    Planta* plantas_esperando; // Plantas listas para disparar pero sin zombies en la fila
+    int cant_plantas;
+    ZombieNode** zombies_por_x; // Índice: los mismos zombies en un array, de menor a mayor x,
+    int inicio_zombies;         // ocupando zombies_por_x[inicio_zombies, inicio + zombies_activos)
+    int capacidad_zombies;
+    int* indices_arvejas;     // Bucket: índices en board->arvejas de esta fila, ordenados por x
+    int cant_arvejas;
+    int capacidad_arvejas;
+    int primer_golpe;         // Tramo de board->golpes donde la fila anota sus golpes
+    int cant_golpes;          // (ver detectarColisiones)
 } GardenRow;
 
+// Un cambio al board pedido desde afuera de la simulación (el input)
+typedef struct {
+    int tipo; // COMANDO_PLANTAR, COMANDO_SACAR_PLANTA o COMANDO_ZOMBIE
+    int row;
+    int col;  // No se usa en COMANDO_ZOMBIE
+} Comando;
+
+// Cola circular de comandos de un productor (el input) y un consumidor
+// (gameBoardUpdate), sin locks: cada contador lo escribe un solo lado y
+// solo crece; el lugar de un comando es su número módulo COLA_COMANDOS.
+typedef struct {
+    Comando comandos[COLA_COMANDOS];
+    SDL_atomic_t escritos; // comandos que publicó el productor
+    SDL_atomic_t leidos;   // comandos que ya aplicó el consumidor
+} ColaComandos;
+
+struct GameBoard;
+
+// Un trabajo del update: aplicar 'funcion' a un tramo [desde, hasta) de
+// algo de una fila (o de todo el board, con fila -1).
+typedef struct {
+    void (*funcion)(struct GameBoard* board, int fila, int desde, int hasta);
+    int fila;
+    int desde;
+    int hasta;
+} Trabajo;
+
+// Cola de trabajos de un hilo (deque): el dueño saca del fondo y los demás
+// le roban del frente. La protege un spinlock, que se toma muy poco tiempo.
+typedef struct {
+    Trabajo* trabajos;
+    int capacidad;
+    int frente;          // primer trabajo que queda
+    int fondo;           // uno después del último
+    SDL_SpinLock candado;
+} ColaTrabajos;
+
+// Pool de hilos con robo de trabajo para el update (ver gameBoardSetHilos).
+// Los trabajos de una tanda se reparten entre las colas; cada hilo hace los
+// de la suya y, cuando se le acaban, le roba a las otras. Entre tanda y
+// tanda los hilos duermen en 'hay_trabajo'.
+typedef struct PoolHilos {
+    SDL_Thread** hilos;
+    int cant_hilos;
+    ColaTrabajos* colas;     // cant_hilos + 1 colas: la 0 es del hilo principal
+    int proxima_cola;        // cola a la que va el próximo trabajo (reparto circular)
+    SDL_atomic_t pendientes; // trabajos encolados que todavía no terminaron
+    SDL_atomic_t arrancados; // para que cada hilo tome su cola al arrancar
+    struct GameBoard* board;
+    SDL_mutex* mutex;
+    SDL_cond* hay_trabajo;   // se avisa al empezar una tanda (o al cerrar el pool)
+    SDL_cond* termino;       // se avisa al terminar el último trabajo pendiente
+    int tanda;               // cambia con cada tanda nueva
+    int cerrar;              // 1: los hilos tienen que salir
+} PoolHilos;
+
 typedef struct GameBoard {
     GardenRow rows[GRID_ROWS];
-    Arveja arvejas[MAX_ARVEJAS]; //array adicional para manejar las arvejas
-    int zombie_spawn_timer; // variable para saber cada cuanto crear un zombie
+    int filas_con_plantas;   // bit r = la fila r tiene alguna planta
+    int filas_con_zombies;   // bit r = la fila r tiene algún zombie
+    int filas_con_arvejas;   // bit r = la fila r tiene alguna arveja en vuelo
+    Arveja* arvejas; //array dinámico adicional para manejar las arvejas
+    int* arvejas_x;          // posición de cada arveja en punto fijo 16.16 (paralelo a 'arvejas')
+    int* arvejas_fila;       // fila de cada arveja, no cambia nunca (paralelo a 'arvejas')
+    int cant_arvejas;        // arvejas en vuelo: ocupan arvejas[0, cant_arvejas)
+    int arvejas_capacidad;   // cantidad de slots de 'arvejas' (crece duplicando)
+    int arvejas_max_activas; // máximo de arvejas en vuelo a la vez (para dimensionar)
+    int arvejas_descartadas; // disparos perdidos por no poder agrandar el array
+    int tick;                // cantidad de ticks (gameBoardUpdate) desde que empezó
+    int modo_eventos;        // 1: colisiones por tiempo de impacto (ver gameBoardSetModoEventos)
+    int* impactos;           // cola de prioridad (min-heap) de índices de arvejas por tick_impacto
+    int cant_impactos;
+    Golpe* golpes;           // impactos del último tick (como mucho uno por arveja)
+    int cant_golpes;
+    Planta* rueda_plantas[RUEDA_PLANTAS]; // rueda de tiempos: slot = tick % RUEDA_PLANTAS
+    int proximo_spawn;      // tick del próximo zombie aleatorio (si no hay oleadas cargadas)
+    int oleadas_cargadas;   // 1 si se cargó un archivo de oleadas (reemplaza al spawn aleatorio)
+    EventoOleada* oleadas;  // línea de tiempo de oleadas, ordenada por tick
+    int cant_oleadas;
+    int proxima_oleada;     // índice del próximo evento que falta spawnear
+    ZombieBlock* zombie_blocks; // bloques de nodos de zombie pedidos al sistema
+    ZombieNode* free_zombies;   // nodos libres para reutilizar (enlazados por 'next')
+    int free_zombie_count;
+    ZombieNode** zombie_slots;  // tabla de slots: índice de handle -> nodo
+    int zombie_slot_count;
+    int zombie_slot_capacity;
+    PoolHilos* pool;            // hilos del update por filas (NULL: todo en el hilo principal)
+    ColaComandos comandos;      // cambios pedidos por el input, se aplican al empezar cada tick
 } GameBoard;
 
 
@@ -113,15 +292,132 @@ GameBoard* game_board = NULL;
 
 
 //========= GAME BOARD NEW =========
+
+/**
+ * Agranda el array de arvejas hasta tener al menos 'capacidad' slots.
+ * La capacidad como mínimo se duplica, así el costo de agrandar queda
+ * amortizado en O(1) por disparo. Devuelve 0 si falla realloc.
+ */
+static int reservarArvejas(GameBoard* board, int capacidad) {
+    if (capacidad <= board->arvejas_capacidad) {
+        return 1;
+    }
+    int nueva_capacidad = board->arvejas_capacidad * 2;
+    if (nueva_capacidad < capacidad) {
+        nueva_capacidad = capacidad;
+    }
+
+    Arveja* arvejas = realloc(board->arvejas, nueva_capacidad * sizeof(Arveja));
+    if (arvejas == NULL) {
+        return 0;
+    }
+    board->arvejas = arvejas;
+
+    // La posición y la fila van en arrays paralelos del mismo tamaño
+    int* arvejas_x = realloc(board->arvejas_x, nueva_capacidad * sizeof(int));
+    if (arvejas_x == NULL) {
+        return 0;
+    }
+    board->arvejas_x = arvejas_x;
+    int* arvejas_fila = realloc(board->arvejas_fila, nueva_capacidad * sizeof(int));
+    if (arvejas_fila == NULL) {
+        return 0;
+    }
+    board->arvejas_fila = arvejas_fila;
+
+    // La cola de impactos tiene como mucho una entrada por arveja, así que
+    // crece junto con el array y nunca hace falta agrandarla al insertar
+    int* impactos = realloc(board->impactos, nueva_capacidad * sizeof(int));
+    if (impactos == NULL) {
+        return 0;
+    }
+    board->impactos = impactos;
+
+    // Igual con el buffer de golpes: cada arveja impacta como mucho una vez
+    Golpe* golpes = realloc(board->golpes, nueva_capacidad * sizeof(Golpe));
+    if (golpes == NULL) {
+        return 0;
+    }
+    board->golpes = golpes;
+    board->arvejas_capacidad = nueva_capacidad;
+    return 1;
+}
+
+/**
+ * x en píxeles de la arveja 'i' (la parte entera de su posición).
+ */
+static inline int xDeArveja(const GameBoard* board, int i) {
+    return FX_TO_INT(board->arvejas_x[i]);
+}
+
+/**
+ * Rectángulo de la arveja 'i', para la colisión y el dibujo. Solo la x
+ * cambia; la y sale de su fila (centrada como la planta que la disparó).
+ */
+static inline SDL_Rect rectDeArveja(const GameBoard* board, int i) {
+    SDL_Rect rect;
+    rect.x = xDeArveja(board, i);
+    rect.y = GRID_OFFSET_Y + (board->arvejas_fila[i] * CELL_HEIGHT) + (CELL_HEIGHT / 4);
+    rect.w = PEA_SIZE;
+    rect.h = PEA_SIZE;
+    return rect;
+}
+
 GameBoard* gameBoardNew() {
     GameBoard* board = (GameBoard*)malloc(sizeof(GameBoard));
     if (!board) return NULL;
 
-    board->zombie_spawn_timer = ZOMBIE_SPAWN_RATE;
+    board->proximo_spawn = ZOMBIE_SPAWN_RATE;
+    board->pool = NULL;
+    SDL_AtomicSet(&board->comandos.escritos, 0);
+    SDL_AtomicSet(&board->comandos.leidos, 0);
+    board->filas_con_plantas = 0;
+    board->filas_con_zombies = 0;
+    board->filas_con_arvejas = 0;
+    board->oleadas_cargadas = 0;
+    board->oleadas = NULL;
+    board->cant_oleadas = 0;
+    board->proxima_oleada = 0;
+    board->zombie_blocks = NULL;
+    board->free_zombies = NULL;
+    board->free_zombie_count = 0;
+    board->zombie_slots = NULL;
+    board->zombie_slot_count = 0;
+    board->zombie_slot_capacity = 0;
+
+    board->arvejas = NULL;
+    board->arvejas_x = NULL;
+    board->arvejas_fila = NULL;
+    board->cant_arvejas = 0;
+    board->arvejas_capacidad = 0;
+    board->arvejas_max_activas = 0;
+    board->arvejas_descartadas = 0;
+    board->tick = 0;
+    board->modo_eventos = 0;
+    board->impactos = NULL;
+    board->cant_impactos = 0;
+    board->golpes = NULL;
+    board->cant_golpes = 0;
+    for (int i = 0; i < RUEDA_PLANTAS; i++) {
+        board->rueda_plantas[i] = NULL;
+    }
+    if (!reservarArvejas(board, ARVEJAS_INICIALES)) {
+        free(board->arvejas);
+        free(board->arvejas_x);
+        free(board->arvejas_fila);
+        free(board->impactos);
+        free(board);
+        return NULL;
+    }
 
     for (int i = 0; i < GRID_ROWS; i++) {
         RowSegment* first = (RowSegment*)malloc(sizeof(RowSegment));
         if (!first) {
+            free(board->arvejas);
+            free(board->arvejas_x);
+            free(board->arvejas_fila);
+            free(board->impactos);
+            free(board->golpes);
             free(board);
             return NULL;
         }
@@ -133,14 +429,283 @@ GameBoard* gameBoardNew() {
 
         board->rows[i].first_segment = first;
         board->rows[i].first_zombie = NULL;
-    }
-     for(int i = 0; i < MAX_ARVEJAS; i++) {
-        board->arvejas[i].activo = 0;
+        board->rows[i].front_zombie = NULL;
+        board->rows[i].zombies_activos = 0;
+        board->rows[i].plantas_esperando = NULL;
+        board->rows[i].cant_plantas = 0;
+        board->rows[i].primer_golpe = 0;
+        board->rows[i].cant_golpes = 0;
+        board->rows[i].zombies_por_x = NULL;
+        board->rows[i].inicio_zombies = 0;
+        board->rows[i].capacidad_zombies = 0;
+        board->rows[i].indices_arvejas = NULL;
+        board->rows[i].cant_arvejas = 0;
+        board->rows[i].capacidad_arvejas = 0;
     }
     return board;
 }
 
 
+/**
+ * Reserva de antemano lugar para 'cantidad' arvejas en vuelo.
+ * No es obligatorio (el array crece solo), pero sirve para evitar
+ * los realloc en medio del juego cuando ya se sabe cuántas hacen falta
+ * (por ejemplo, usando el 'arvejas_max_activas' de una corrida anterior).
+ * Devuelve 1 si hay lugar, 0 si falla la memoria.
+ */
+int gameBoardReserveArvejas(GameBoard* board, int cantidad) {
+    if (board == NULL) {
+        printf("Error: Board es NULL en gameBoardReserveArvejas\n");
+        return 0;
+    }
+    return reservarArvejas(board, cantidad);
+}
+
+
+
+
+// ========= GAME BOARD HILOS ==========
+
+/**
+ * Agrega un trabajo al fondo de la cola. Devuelve 0 si no hay memoria
+ * para agrandarla.
+ */
+static int empujarTrabajo(ColaTrabajos* cola, Trabajo t) {
+    SDL_AtomicLock(&cola->candado);
+    if (cola->frente == cola->fondo) {
+        cola->frente = cola->fondo = 0; // Vacía: se vuelve a usar desde el principio
+    }
+    if (cola->fondo == cola->capacidad) {
+        int capacidad = cola->capacidad == 0 ? 16 : cola->capacidad * 2;
+        Trabajo* trabajos = realloc(cola->trabajos, capacidad * sizeof(Trabajo));
+        if (trabajos == NULL) {
+            SDL_AtomicUnlock(&cola->candado);
+            return 0;
+        }
+        cola->trabajos = trabajos;
+        cola->capacidad = capacidad;
+    }
+    cola->trabajos[cola->fondo++] = t;
+    SDL_AtomicUnlock(&cola->candado);
+    return 1;
+}
+
+/**
+ * Saca un trabajo de la cola: del fondo si es el dueño (el último que
+ * encoló), del frente si es un robo. Devuelve 0 si estaba vacía.
+ */
+static int sacarTrabajo(ColaTrabajos* cola, int robo, Trabajo* t) {
+    int hay = 0;
+    SDL_AtomicLock(&cola->candado);
+    if (cola->fondo > cola->frente) {
+        *t = robo ? cola->trabajos[cola->frente++] : cola->trabajos[--cola->fondo];
+        hay = 1;
+    }
+    SDL_AtomicUnlock(&cola->candado);
+    return hay;
+}
+
+/**
+ * Hace trabajos hasta que no quede ninguno por tomar: primero los de la
+ * cola propia ('yo'), después los que pueda robarle a las demás.
+ */
+static void hacerTrabajos(PoolHilos* pool, int yo) {
+    int cant_colas = pool->cant_hilos + 1;
+    Trabajo t;
+    while (1) {
+        int hay = sacarTrabajo(&pool->colas[yo], 0, &t);
+        for (int k = 1; !hay && k < cant_colas; k++) {
+            hay = sacarTrabajo(&pool->colas[(yo + k) % cant_colas], 1, &t);
+        }
+        if (!hay) {
+            return;
+        }
+        t.funcion(pool->board, t.fila, t.desde, t.hasta);
+        if (SDL_AtomicAdd(&pool->pendientes, -1) == 1) {
+            SDL_LockMutex(pool->mutex);
+            SDL_CondSignal(pool->termino);
+            SDL_UnlockMutex(pool->mutex);
+        }
+    }
+}
+
+/**
+ * Bucle de cada hilo del pool: espera una tanda nueva, hace y roba
+ * trabajos mientras haya, y vuelve a esperar, hasta que se cierra el pool.
+ */
+static int trabajadorDelPool(void* datos) {
+    PoolHilos* pool = (PoolHilos*)datos;
+    int yo = SDL_AtomicAdd(&pool->arrancados, 1) + 1;
+    int tanda_vista = 0;
+    SDL_LockMutex(pool->mutex);
+    while (1) {
+        while (!pool->cerrar && pool->tanda == tanda_vista) {
+            SDL_CondWait(pool->hay_trabajo, pool->mutex);
+        }
+        if (pool->cerrar) {
+            break;
+        }
+        tanda_vista = pool->tanda;
+        SDL_UnlockMutex(pool->mutex);
+        hacerTrabajos(pool, yo);
+        SDL_LockMutex(pool->mutex);
+    }
+    SDL_UnlockMutex(pool->mutex);
+    return 0;
+}
+
+/**
+ * Avisa a los hilos que terminen, los espera y libera el pool.
+ * Acepta NULL (board sin hilos) y pools a medio crear.
+ */
+static void cerrarPool(PoolHilos* pool) {
+    if (pool == NULL) {
+        return;
+    }
+    if (pool->mutex != NULL && pool->hay_trabajo != NULL) {
+        SDL_LockMutex(pool->mutex);
+        pool->cerrar = 1;
+        SDL_CondBroadcast(pool->hay_trabajo);
+        SDL_UnlockMutex(pool->mutex);
+    }
+    for (int h = 0; h < pool->cant_hilos; h++) {
+        SDL_WaitThread(pool->hilos[h], NULL);
+    }
+    if (pool->colas != NULL) {
+        for (int c = 0; c <= pool->cant_hilos; c++) {
+            free(pool->colas[c].trabajos);
+        }
+    }
+    if (pool->termino != NULL) SDL_DestroyCond(pool->termino);
+    if (pool->hay_trabajo != NULL) SDL_DestroyCond(pool->hay_trabajo);
+    if (pool->mutex != NULL) SDL_DestroyMutex(pool->mutex);
+    free(pool->colas);
+    free(pool->hilos);
+    free(pool);
+}
+
+/**
+ * Crea un pool con 'cant_hilos' hilos trabajadores para el board. Devuelve
+ * NULL si falla la memoria o SDL (y no deja nada creado).
+ */
+static PoolHilos* crearPool(GameBoard* board, int cant_hilos) {
+    PoolHilos* pool = (PoolHilos*)calloc(1, sizeof(PoolHilos));
+    if (pool == NULL) {
+        return NULL;
+    }
+    pool->board = board;
+    pool->hilos = (SDL_Thread**)malloc(cant_hilos * sizeof(SDL_Thread*));
+    pool->colas = (ColaTrabajos*)calloc(cant_hilos + 1, sizeof(ColaTrabajos));
+    pool->mutex = SDL_CreateMutex();
+    pool->hay_trabajo = SDL_CreateCond();
+    pool->termino = SDL_CreateCond();
+    if (pool->hilos == NULL || pool->colas == NULL || pool->mutex == NULL ||
+        pool->hay_trabajo == NULL || pool->termino == NULL) {
+        cerrarPool(pool);
+        return NULL;
+    }
+    for (int h = 0; h < cant_hilos; h++) {
+        pool->hilos[h] = SDL_CreateThread(trabajadorDelPool, "update", pool);
+        if (pool->hilos[h] == NULL) {
+            cerrarPool(pool); // Cierra los que sí se crearon
+            return NULL;
+        }
+        pool->cant_hilos++;
+    }
+    return pool;
+}
+
+/**
+ * Encola un trabajo para la tanda actual (se hace en esperarTrabajos).
+ * Sin pool, o si no hay memoria para encolarlo, se hace en el momento:
+ * los trabajos de una tanda no dependen entre sí.
+ */
+static void encolarTrabajo(GameBoard* board, void (*funcion)(GameBoard* board, int fila, int desde, int hasta),
+                           int fila, int desde, int hasta) {
+    PoolHilos* pool = board->pool;
+    if (pool != NULL) {
+        Trabajo t = {funcion, fila, desde, hasta};
+        SDL_AtomicAdd(&pool->pendientes, 1);
+        if (empujarTrabajo(&pool->colas[pool->proxima_cola], t)) {
+            pool->proxima_cola = (pool->proxima_cola + 1) % (pool->cant_hilos + 1);
+            return;
+        }
+        SDL_AtomicAdd(&pool->pendientes, -1);
+    }
+    funcion(board, fila, desde, hasta);
+}
+
+/**
+ * Parallel-for por tramos: parte [0, cantidad) en tramos de 'tramo'
+ * elementos y encola un trabajo por tramo. Así una fila con muchos más
+ * zombies que las otras se reparte entre varios hilos.
+ */
+static void paraleloPorTramos(GameBoard* board, void (*funcion)(GameBoard* board, int fila, int desde, int hasta),
+                              int fila, int cantidad, int tramo) {
+    for (int desde = 0; desde < cantidad; desde += tramo) {
+        int hasta = desde + tramo < cantidad ? desde + tramo : cantidad;
+        encolarTrabajo(board, funcion, fila, desde, hasta);
+    }
+}
+
+/**
+ * Despierta a los hilos, hace trabajos en el principal también, y vuelve
+ * cuando terminaron todos los encolados. Sin pool no hay nada que esperar.
+ */
+static void esperarTrabajos(GameBoard* board) {
+    PoolHilos* pool = board->pool;
+    if (pool == NULL) {
+        return;
+    }
+    SDL_LockMutex(pool->mutex);
+    pool->tanda++;
+    SDL_CondBroadcast(pool->hay_trabajo);
+    SDL_UnlockMutex(pool->mutex);
+
+    hacerTrabajos(pool, 0);
+
+    SDL_LockMutex(pool->mutex);
+    while (SDL_AtomicGet(&pool->pendientes) > 0) {
+        SDL_CondWait(pool->termino, pool->mutex);
+    }
+    SDL_UnlockMutex(pool->mutex);
+}
+
+/**
+ * Elige en cuántos hilos se hace gameBoardUpdate (contando el principal).
+ * Con más de uno, las fases que no cruzan datos entre filas se reparten
+ * como trabajos: mover zombies (por tramos de cada fila), mover arvejas
+ * (por tramos del array) y detectar golpes (una fila por trabajo). El
+ * resto (disparos, aplicar golpes, sacar arvejas y spawns) sigue en el
+ * hilo principal y en orden de filas, así que el resultado es idéntico
+ * al de un solo hilo.
+ * Devuelve 1 si pudo, 0 si hubo un error (y el board queda sin hilos).
+ */
+int gameBoardSetHilos(GameBoard* board, int cantidad) {
+    if (board == NULL) {
+        printf("Error: Board NULL en gameBoardSetHilos\n");
+        return 0;
+    }
+    if (cantidad < 1) {
+        printf("Error: Cantidad de hilos invalida (%d)\n", cantidad);
+        return 0;
+    }
+
+    cerrarPool(board->pool);
+    board->pool = NULL;
+    if (cantidad == 1) {
+        return 1;
+    }
+
+    board->pool = crearPool(board, cantidad - 1);
+    if (board->pool == NULL) {
+        printf("Error: No se pudieron crear los hilos del update: %s\n", SDL_GetError());
+        return 0;
+    }
+    return 1;
+}
+
+
 
 
 // ========= GAME BOARD DELETE=========
@@ -169,15 +734,16 @@ static void freeSegments(RowSegment* head) {
 }
 
 /**
- * Libera una lista enlazada simple de zombies (ZombieNode).
- * La idea es recorrer la lista y liberar cada nodo.
+ * Libera los bloques de nodos de zombie (ZombieBlock).
+ * Los nodos no se liberan de a uno: viven dentro de bloques,
+ * así que alcanza con recorrer la lista de bloques y liberar cada uno.
  * Se guarda el puntero 'next' antes de liberar 'current'
  * para no perder la referencia al resto de la lista.
  */
-static void freeZombies(ZombieNode* head) {
-    ZombieNode* current = head;
+static void freeZombieBlocks(ZombieBlock* head) {
+    ZombieBlock* current = head;
     while (current != NULL) {
-        ZombieNode* next = current->next;  // Guardo el siguiente
+        ZombieBlock* next = current->next;  // Guardo el siguiente
         free(current);
         current = next;
     }
@@ -188,21 +754,41 @@ static void freeZombies(ZombieNode* head) {
  * Esta es la función principal de limpieza que cumple la consigna.
  * La idea es aplicar una limpieza "de abajo hacia arriba":
  * 1. Recorre cada fila.
- * 2. Libera las listas de Segmentos y Zombies de esa fila (usando helpers).
- * 3. Finalmente, libera el GameBoard.
+ * 2. Libera la lista de Segmentos de esa fila (usando helpers).
+ * 3. Libera los bloques de zombies y el array de arvejas.
+ * 4. Finalmente, libera el GameBoard.
  */
 void gameBoardDelete(GameBoard* board) {
     // Si el puntero es NULL, no hay nada que hacer.
     if (board == NULL) {
         return;
     }
+
+    // Los hilos del update (si había) terminan antes de liberar lo que usan
+    cerrarPool(board->pool);
     
     // Recorro cada fila del tablero
     for (int row = 0; row < GRID_ROWS; row++) {
-        // Libero las listas enlazadas de esta fila
+        // Libero la lista de segmentos, el bucket de arvejas y el índice de zombies
         freeSegments(board->rows[row].first_segment);
-        freeZombies(board->rows[row].first_zombie);
+        free(board->rows[row].indices_arvejas);
+        free(board->rows[row].zombies_por_x);
     }
+
+    // Los zombies (vivos o en el pool) viven en los bloques
+    freeZombieBlocks(board->zombie_blocks);
+    free(board->zombie_slots);
+
+    // Línea de tiempo de oleadas (si se cargó una)
+    free(board->oleadas);
+
+    // Array dinámico de arvejas (y sus arrays paralelos), su cola de
+    // impactos y el buffer de golpes
+    free(board->arvejas);
+    free(board->arvejas_x);
+    free(board->arvejas_fila);
+    free(board->impactos);
+    free(board->golpes);
     
     // Una vez liberado todo el contenido, libero el contenedor principal
     free(board);
@@ -213,6 +799,124 @@ void gameBoardDelete(GameBoard* board) {
 
 
 
+// ========= GAME BOARD RUEDA DE PLANTAS ==========
+
+/**
+ * Lista en la que está la planta: el slot de la rueda de su tick, o la de
+ * plantas esperando zombies de su fila si tick_rueda es -1.
+ */
+static Planta** listaDePlanta(GameBoard* board, Planta* p) {
+    if (p->tick_rueda < 0) {
+        return &board->rows[p->row].plantas_esperando;
+    }
+    return &board->rueda_plantas[p->tick_rueda & (RUEDA_PLANTAS - 1)];
+}
+
+static void engancharPlanta(Planta** lista, Planta* p) {
+    p->rueda_ant = NULL;
+    p->rueda_sig = *lista;
+    if (*lista != NULL) {
+        (*lista)->rueda_ant = p;
+    }
+    *lista = p;
+}
+
+/**
+ * Saca la planta de la lista en la que esté (O(1), doble enlace).
+ * Hay que llamarla antes de liberar una planta.
+ */
+static void desengancharPlanta(GameBoard* board, Planta* p) {
+    if (p->rueda_ant != NULL) {
+        p->rueda_ant->rueda_sig = p->rueda_sig;
+    } else {
+        Planta** lista = listaDePlanta(board, p);
+        if (*lista == p) {
+            *lista = p->rueda_sig;
+        }
+    }
+    if (p->rueda_sig != NULL) {
+        p->rueda_sig->rueda_ant = p->rueda_ant;
+    }
+    p->rueda_ant = NULL;
+    p->rueda_sig = NULL;
+}
+
+/**
+ * Pone la planta en la rueda para que se la mire recién en 'tick'.
+ * La rueda es un array de listas indexado por tick % RUEDA_PLANTAS: cada
+ * tick solo se recorre su slot. Si el tick está más de una vuelta
+ * adelante, la planta queda en el slot y se saltea hasta que llegue.
+ */
+static void programarPlanta(GameBoard* board, Planta* p, int tick) {
+    p->tick_rueda = tick;
+    engancharPlanta(listaDePlanta(board, p), p);
+}
+
+/**
+ * Deja a la planta esperando zombies en su fila: no se la mira más
+ * hasta que spawnee uno (ver despertarPlantas).
+ */
+static void esperarZombies(GameBoard* board, Planta* p) {
+    p->tick_rueda = -1;
+    engancharPlanta(listaDePlanta(board, p), p);
+}
+
+/**
+ * Devuelve a la rueda las plantas que esperaban zombies en la fila, para
+ * que en el próximo tick se fijen si ya tienen a quién dispararle.
+ */
+static void despertarPlantas(GameBoard* board, int row) {
+    Planta* p = board->rows[row].plantas_esperando;
+    board->rows[row].plantas_esperando = NULL;
+    while (p != NULL) {
+        Planta* sig = p->rueda_sig;
+        programarPlanta(board, p, board->tick + 1);
+        p = sig;
+    }
+}
+
+/**
+ * Cuando entran zombies nuevos a la fila, las plantas con alcance que
+ * esperaban en la rueda a que el zombie más cercano entrara en rango
+ * pueden tener uno más cerca (un zombie nuevo puede quedar adelante de
+ * los que ya estaban): se vuelven a fijar en el próximo tick.
+ * Las plantas de una fila son pocas (una por columna como mucho).
+ */
+static void despertarPlantasConAlcance(GameBoard* board, int row) {
+    for (RowSegment* seg = board->rows[row].first_segment; seg != NULL; seg = seg->next) {
+        Planta* p = seg->planta_data;
+        if (p != NULL && p->esperando_rango && p->tick_rueda > board->tick + 1) {
+            desengancharPlanta(board, p);
+            programarPlanta(board, p, board->tick + 1);
+        }
+    }
+}
+
+/**
+ * Frame de animación de la planta en el tick actual. No se guarda ni se
+ * avanza en cada tick: todas las plantas animan igual, así que alcanza
+ * con los ticks que pasaron desde que se plantó (su fase). Se calcula
+ * solo al dibujarla.
+ */
+static int framePlanta(GameBoard* board, Planta* p) {
+    return ((board->tick - p->fase) / PEASHOOTER_ANIMATION_SPEED) % PEASHOOTER_TOTAL_FRAMES;
+}
+
+/**
+ * Saca de la rueda todas las plantas de una fila (antes de liberarlas).
+ */
+static void desengancharPlantasDeFila(GameBoard* board, int row) {
+    for (RowSegment* seg = board->rows[row].first_segment; seg != NULL; seg = seg->next) {
+        if (seg->planta_data != NULL) {
+            desengancharPlanta(board, seg->planta_data);
+        }
+    }
+}
+
+
+
+
+
 // ========= GAME BOARD ADD PLANT ==========
 
 /**
@@ -233,9 +937,14 @@ static Planta* createPlanta(int row, int col) {
     p->rect.h = CELL_HEIGHT;
     p->activo = 1;
     p->cooldown = rand() % 100; // Cooldown inicial aleatorio
-    p->current_frame = 0;
-    p->frame_timer = 0;
+    p->fase = 0;
     p->debe_disparar = 0;
+    p->alcance = 0; // El lanzaguisantes común llega a toda la fila
+    p->row = row;
+    p->tick_rueda = -1;
+    p->esperando_rango = 0;
+    p->rueda_ant = NULL;
+    p->rueda_sig = NULL;
     return p;
 }
 
@@ -244,8 +953,12 @@ static Planta* createPlanta(int row, int col) {
  * Resuelve la necesidad de los tests de empezar con una fila limpia,
  * liberando la lista de segmentos existente y creando una nueva.
  */
-static void resetRow(GardenRow* row) {
+static void resetRow(GameBoard* board, int r) {
+    GardenRow* row = &board->rows[r];
+    desengancharPlantasDeFila(board, r); // Las plantas dejan la rueda antes de liberarse
     freeSegments(row->first_segment); // Libera la lista vieja
+    row->cant_plantas = 0;
+    board->filas_con_plantas &= ~(1 << r);
     row->first_segment = malloc(sizeof(RowSegment)); // Crea la nueva
     if (row->first_segment != NULL) {
         row->first_segment->status = STATUS_VACIO;
@@ -256,6 +969,19 @@ static void resetRow(GardenRow* row) {
     }
 }
 
+/**
+ * Anota una planta recién plantada en el board: la fila pasa a estar
+ * activa para el draw, y la planta entra en la rueda (su cooldown inicial
+ * termina 'cooldown' ticks después del próximo tick). Su animación
+ * arranca en el frame 0 ahora mismo (ver framePlanta).
+ */
+static void registrarPlanta(GameBoard* board, Planta* p) {
+    board->rows[p->row].cant_plantas++;
+    board->filas_con_plantas |= 1 << p->row;
+    p->fase = board->tick;
+    programarPlanta(board, p, board->tick + p->cooldown + 1);
+}
+
 /**
  * Agrega una planta en la grilla (fila y columna).
  * La idea es buscar en la lista de RowSegment el segmento VACIO que
@@ -339,6 +1065,7 @@ int gameBoardAddPlant(GameBoard* board, int row, int col) {
                         prev->next = planta_seg;
                     }
                 }
+                registrarPlanta(board, planta_seg->planta_data);
                 return 1; // Éxito
             }
             
@@ -349,6 +1076,7 @@ int gameBoardAddPlant(GameBoard* board, int row, int col) {
                 // Insertamos planta_seg *después* de current
                 planta_seg->next = current->next;
                 current->next = planta_seg;
+                registrarPlanta(board, planta_seg->planta_data);
                 return 1; // Éxito
             }
             
@@ -377,6 +1105,7 @@ int gameBoardAddPlant(GameBoard* board, int row, int col) {
                 planta_seg->next = right_seg;
                 current->next = planta_seg;
                 
+                registrarPlanta(board, planta_seg->planta_data);
                 return 1; // Éxito
             }
         }
@@ -441,8 +1170,12 @@ void gameBoardRemovePlant(GameBoard* board, int row, int col) {
 
             // 1. CONVERTIR A VACIO Y LIBERAR PLANTA
             // Libero la memoria anidada de la planta
+            desengancharPlanta(board, current->planta_data);
             free(current->planta_data);
             current->planta_data = NULL;
+            if (--board->rows[row].cant_plantas == 0) {
+                board->filas_con_plantas &= ~(1 << row);
+            }
             // Convierto el segmento en VACIO
             current->status = STATUS_VACIO;
 
@@ -484,1016 +1217,3953 @@ void gameBoardRemovePlant(GameBoard* board, int row, int col) {
 
 
 
-//======== GAME BOARD ADD ZOMBIE ==========
+// ========= GAME BOARD SET PLANT RANGE ==========
 
 /**
- * Crea un nuevo zombie (ZombieNode) con memoria dinámica y lo
- * agrega a la lista enlazada de la fila correspondiente.
- *
- * Esta función resuelve la limitación del array estático del juego base,
- * permitiendo un número virtualmente ilimitado de zombies.
- * La idea principal es usar la inserción al principio de la lista (O(1)),
- * que es la forma más eficiente de agregar un nodo.
+ * Le da un alcance de disparo (en píxeles, medido desde donde sale la
+ * arveja) a la planta de la celda (row, col). Con alcance 0 la planta
+ * vuelve a llegar a toda la fila, como el lanzaguisantes común.
+ * Una planta con alcance solo dispara si el zombie más cercano que tiene
+ * adelante está dentro del alcance (ver gameBoardNearestZombieAhead).
+ * Devuelve 1 si había una planta en la celda, 0 si no.
  */
-void gameBoardAddZombie(GameBoard* board, int row) {
-    // Validación: chequeo de puntero NULL e índice de fila
+int gameBoardSetPlantRange(GameBoard* board, int row, int col, int alcance) {
+    // ===== VALIDACIONES =====
     if (board == NULL) {
-        printf("Error: Board es NULL en gameBoardAddZombie\n");
-        return;
+        printf("Error: Board es NULL en gameBoardSetPlantRange\n");
+        return 0;
     }
     if (row < 0 || row >= GRID_ROWS) {
-        printf("Error: Row %d inválida (debe ser 0-%d) en gameBoardAddZombie\n", 
-               row, GRID_ROWS - 1);
-        return;
+        printf("Error: Row %d invalida en gameBoardSetPlantRange\n", row);
+        return 0;
     }
-    
-    // 1. Asigno memoria en el heap para el nuevo nodo (el "contenedor")
-    ZombieNode* nuevo_nodo = malloc(sizeof(ZombieNode));
-    if (nuevo_nodo == NULL) {
-        printf("Error: No se pudo asignar memoria para el zombie\n");
-        return;
+    if (col < 0 || col >= GRID_COLS) {
+        printf("Error: Col %d invalida en gameBoardSetPlantRange\n", col);
+        return 0;
     }
-    
-    // 2. Inicializo los datos del zombie (el "contenido")
-    nuevo_nodo->zombie_data.row = row;
-    nuevo_nodo->zombie_data.pos_x = SCREEN_WIDTH;  // Spawnea fuera de pantalla
-    nuevo_nodo->zombie_data.rect.x = (int)nuevo_nodo->zombie_data.pos_x;
-    
-    // Ajuste para que el rect se ajuste al tamaño de la celda (como en el original)
-    nuevo_nodo->zombie_data.rect.y = GRID_OFFSET_Y + (row * CELL_HEIGHT);
-    
-    // Dimensiones ajustadas a la celda para escalado automático en render
-    nuevo_nodo->zombie_data.rect.w = CELL_WIDTH;
-    nuevo_nodo->zombie_data.rect.h = CELL_HEIGHT;
-    
-    // Valores iniciales estándar
-    nuevo_nodo->zombie_data.vida = 100;
-    nuevo_nodo->zombie_data.activo = 1;
-    nuevo_nodo->zombie_data.current_frame = 0;
-    nuevo_nodo->zombie_data.frame_timer = 0;
-    
-    // 3. Agrego el nodo al PRINCIPIO de la lista (Head Insertion)
-    nuevo_nodo->next = board->rows[row].first_zombie;
-    board->rows[row].first_zombie = nuevo_nodo;
-}
 
+    // ===== BUSCAR EL SEGMENTO QUE CONTIENE LA COLUMNA =====
+    for (RowSegment* seg = board->rows[row].first_segment; seg != NULL; seg = seg->next) {
+        if (col >= seg->start_col && col < seg->start_col + seg->length) {
+            if (seg->status != STATUS_PLANTA || seg->planta_data == NULL) {
+                return 0;
+            }
+            Planta* p = seg->planta_data;
+            p->alcance = alcance > 0 ? alcance : 0;
+            if (p->esperando_rango || p->tick_rueda < 0) {
+                // Esperaba según el alcance viejo (en la rueda hasta que
+                // el zombie entrara en rango, o fuera de la rueda porque no
+                // tenía ninguno adelante): que se vuelva a fijar. Si está
+                // en cooldown o armando el disparo no se toca: en su tick
+                // ya mira el blanco con el alcance nuevo.
+                desengancharPlanta(board, p);
+                programarPlanta(board, p, board->tick + 1);
+            }
+            return 1;
+        }
+    }
+    return 0;
+}
 
 
 
 
 
-// ========= GAME BOARD UPDATE ==========
+// ========= GAME BOARD IMPACTOS ==========
 
 /**
- * Helper para crear una nueva arveja.
+ * Orden de la cola de impactos: primero el tick en el que hay que resolver
+ * la arveja y, dentro del mismo tick, de menor a mayor x (el mismo orden en
+ * que las recorre el sort-and-sweep). Como todas las arvejas avanzan igual,
+ * comparar las x actuales da siempre el mismo resultado y el heap no se rompe.
  */
-static void dispararArveja(GameBoard* board, Planta* p, int row) {
-    
-    // Busca un 'slot' de arveja inactivo
-    for (int i = 0; i < MAX_ARVEJAS; i++) {
-        if (!board->arvejas[i].activo) {
-            board->arvejas[i].rect.x = p->rect.x + (CELL_WIDTH / 2); // Centrado
-            board->arvejas[i].rect.y = p->rect.y + (CELL_HEIGHT / 4); // Centrado
-            
-            board->arvejas[i].rect.w = 20;
-            board->arvejas[i].rect.h = 20;
+static int impactoAntes(const GameBoard* board, int a, int b) {
+    if (board->arvejas[a].tick_impacto != board->arvejas[b].tick_impacto) {
+        return board->arvejas[a].tick_impacto < board->arvejas[b].tick_impacto;
+    }
+    return board->arvejas_x[a] < board->arvejas_x[b];
+}
+
+static void ponerEnHeap(GameBoard* board, int pos, int i) {
+    board->impactos[pos] = i;
+    board->arvejas[i].pos_en_heap = pos;
+}
+
+static void subirImpacto(GameBoard* board, int pos) {
+    int i = board->impactos[pos];
+    while (pos > 0) {
+        int padre = (pos - 1) / 2;
+        if (!impactoAntes(board, i, board->impactos[padre])) break;
+        ponerEnHeap(board, pos, board->impactos[padre]);
+        pos = padre;
+    }
+    ponerEnHeap(board, pos, i);
+}
 
-            board->arvejas[i].activo = 1;
-            break; // Solo dispara una arveja a la vez
+static void bajarImpacto(GameBoard* board, int pos) {
+    int i = board->impactos[pos];
+    while (1) {
+        int hijo = 2 * pos + 1;
+        if (hijo >= board->cant_impactos) break;
+        if (hijo + 1 < board->cant_impactos &&
+            impactoAntes(board, board->impactos[hijo + 1], board->impactos[hijo])) {
+            hijo++;
         }
+        if (!impactoAntes(board, board->impactos[hijo], i)) break;
+        ponerEnHeap(board, pos, board->impactos[hijo]);
+        pos = hijo;
     }
+    ponerEnHeap(board, pos, i);
 }
 
 /**
- * Helper para manejar el spawn de zombies.
+ * Programa (o reprograma) la arveja 'i' para resolverse en el tick 'tick'.
+ * La cola tiene lugar para todas las arvejas (crece con reservarArvejas),
+ * así que insertar nunca falla. O(log n).
  */
-static void generarZombieSiNecesario(GameBoard* board) {
-    board->zombie_spawn_timer--;
-    if (board->zombie_spawn_timer <= 0) {
-        int random_row = rand() % GRID_ROWS;
-        gameBoardAddZombie(board, random_row); // Llama a la función de inserción
-        board->zombie_spawn_timer = ZOMBIE_SPAWN_RATE; // Resetea el timer
+static void programarImpacto(GameBoard* board, int i, int tick) {
+    Arveja* a = &board->arvejas[i];
+    if (a->pos_en_heap < 0) {
+        a->tick_impacto = tick;
+        ponerEnHeap(board, board->cant_impactos++, i);
+        subirImpacto(board, a->pos_en_heap);
+    } else if (tick < a->tick_impacto) {
+        a->tick_impacto = tick;
+        subirImpacto(board, a->pos_en_heap);
+    } else {
+        a->tick_impacto = tick;
+        bajarImpacto(board, a->pos_en_heap);
     }
 }
 
 /**
- * Avanza el estado del juego un "tick".
+ * Saca la arveja 'i' de la cola de impactos (si estaba). O(log n).
  */
-void gameBoardUpdate(GameBoard* board) {
-    if (board == NULL) {
+static void desprogramarImpacto(GameBoard* board, int i) {
+    int pos = board->arvejas[i].pos_en_heap;
+    if (pos < 0) {
         return;
     }
+    board->arvejas[i].pos_en_heap = -1;
+    int ultimo = board->impactos[--board->cant_impactos];
+    if (ultimo != i) {
+        ponerEnHeap(board, pos, ultimo);
+        subirImpacto(board, pos);
+        bajarImpacto(board, board->arvejas[ultimo].pos_en_heap);
+    }
+}
 
-    // ===== 1. ACTUALIZAR ZOMBIES =====
-    for (int r = 0; r < GRID_ROWS; r++) {
-        ZombieNode* z_node = board->rows[r].first_zombie;
-        ZombieNode* prev_z = NULL;
-        
-        while (z_node != NULL) {
-            Zombie* z = &z_node->zombie_data;
-            
-            if (z->activo) {
-                float distance_per_tick = ZOMBIE_DISTANCE_PER_CYCLE / 
-                    (float)(ZOMBIE_TOTAL_FRAMES * ZOMBIE_ANIMATION_SPEED);
-                z->pos_x -= distance_per_tick;
-                z->rect.x = (int)z->pos_x;
-
-                z->frame_timer++;
-                if (z->frame_timer >= ZOMBIE_ANIMATION_SPEED) {
-                    z->frame_timer = 0;
-                    z->current_frame = (z->current_frame + 1) % ZOMBIE_TOTAL_FRAMES;
-                }
-            }
-
-            if (!z->activo && z->vida <= 0) {
-                ZombieNode* to_free = z_node;
-                
-                if (prev_z == NULL) {
-                    board->rows[r].first_zombie = z_node->next;
-                } else {
-                    prev_z->next = z_node->next;
-                }
-                
-                z_node = z_node->next;
-                free(to_free);
-                continue;
-            }
+/**
+ * Cuando entran zombies nuevos a una fila, cualquier arveja que tenga
+ * alguno de ellos adelante puede ganar un impacto MÁS CERCANO: las que no
+ * tenían blanco, pero también las que apuntaban a un zombie que todavía
+ * está más atrás que el nuevo (por ejemplo, el final de una oleada que
+ * sigue fuera de pantalla). 'borde' es el borde derecho del nuevo zombie
+ * de más adelante: las arvejas que todavía no lo pasaron (el bucket está
+ * ordenado por x, así que son las primeras) se revisan en el próximo
+ * tick, donde el evento se recalcula contra el zombie que tengan adelante.
+ * Las demás no se tocan: si su zombie muere antes, el evento se revisa al
+ * vencer y se reprograma.
+ */
+static void revisarArvejasAlcanzables(GameBoard* board, int row, int borde) {
+    GardenRow* fila = &board->rows[row];
+    for (int k = 0; k < fila->cant_arvejas; k++) {
+        int i = fila->indices_arvejas[k];
+        if (xDeArveja(board, i) >= borde) {
+            break;
+        }
+        programarImpacto(board, i, board->tick);
+    }
+}
 
-            prev_z = z_node;
-            z_node = z_node->next;
+/**
+ * Activa (1) o desactiva (0) el modo de colisiones por eventos.
+ * En modo eventos cada arveja calcula de forma analítica en qué tick va a
+ * tocar al primer zombie que tiene adelante y espera en una cola de
+ * prioridad: el update ya no chequea colisiones arveja por arveja, solo
+ * resuelve los eventos que vencen. El resultado es el mismo que con el
+ * sort-and-sweep. Al activarlo, todas las arvejas en vuelo se revisan
+ * en el próximo tick.
+ */
+void gameBoardSetModoEventos(GameBoard* board, int activo) {
+    if (board == NULL) {
+        printf("Error: Board es NULL en gameBoardSetModoEventos\n");
+        return;
+    }
+    activo = activo ? 1 : 0;
+    if (activo == board->modo_eventos) {
+        return;
+    }
+    board->modo_eventos = activo;
+    board->cant_impactos = 0;
+    for (int i = 0; i < board->cant_arvejas; i++) {
+        board->arvejas[i].pos_en_heap = -1;
+        if (activo) {
+            programarImpacto(board, i, board->tick);
         }
     }
+}
 
-    // ===== 2. ACTUALIZAR PLANTAS =====
-    for (int r = 0; r < GRID_ROWS; r++) {
-        RowSegment* seg = board->rows[r].first_segment;
-        
-        while (seg != NULL) {
-            if (seg->status == STATUS_PLANTA && seg->planta_data != NULL) {
-                Planta* p = seg->planta_data;
 
-                // Lógica de cooldown y disparo
-                if (p->cooldown > 0) {
-                    p->cooldown--;
-                } else {
-                    p->debe_disparar = 1;
-                }
 
-                // Lógica de animación
-                p->frame_timer++;
-                if (p->frame_timer >= PEASHOOTER_ANIMATION_SPEED) {
-                    p->frame_timer = 0;
-                    p->current_frame = (p->current_frame + 1) % PEASHOOTER_TOTAL_FRAMES;
 
-                    if (p->debe_disparar && p->current_frame == PEASHOOTER_SHOOT_FRAME) {
-                        dispararArveja(board, p, r);
-                        p->cooldown = 120; // Reinicio cooldown
-                        p->debe_disparar = 0;
-                    }
-                }
-            }
-            seg = seg->next;
-        }
+
+//======== GAME BOARD ADD ZOMBIE ==========
+
+/**
+ * Pide un bloque de 'cantidad' nodos de zombie con un solo malloc y los
+ * agrega a la lista de nodos libres del board.
+ * La idea es no pagar un malloc por zombie: los nodos salen de bloques
+ * y, cuando un zombie muere, su nodo vuelve a la lista de libres en vez
+ * de liberarse. Los bloques se liberan todos juntos en gameBoardDelete.
+ * Cada nodo nuevo además recibe un slot fijo en la tabla de handles.
+ */
+static int reservarZombies(GameBoard* board, int cantidad) {
+    if (board->free_zombie_count >= cantidad) {
+        return 1; // Ya hay suficientes nodos libres
+    }
+    int faltan = cantidad - board->free_zombie_count;
+    if (faltan < ZOMBIE_BLOCK_SIZE) {
+        faltan = ZOMBIE_BLOCK_SIZE;
     }
 
-    // ===== 3. ACTUALIZAR ARVEJAS =====
-    // (Esta sección no cambia)
-    for (int i = 0; i < MAX_ARVEJAS; i++) {
-        if (board->arvejas[i].activo) {
-            board->arvejas[i].rect.x += PEA_SPEED;
-            
-            if (board->arvejas[i].rect.x > SCREEN_WIDTH) {
-                board->arvejas[i].activo = 0;
-            }
+    // Agrando la tabla de slots si no entran los nodos nuevos (duplicando)
+    int slots_necesarios = board->zombie_slot_count + faltan;
+    if (slots_necesarios > board->zombie_slot_capacity) {
+        int nueva_capacidad = board->zombie_slot_capacity > 0 ? board->zombie_slot_capacity : ZOMBIE_BLOCK_SIZE;
+        while (nueva_capacidad < slots_necesarios) {
+            nueva_capacidad *= 2;
         }
+        ZombieNode** slots = realloc(board->zombie_slots, nueva_capacidad * sizeof(ZombieNode*));
+        if (slots == NULL) {
+            printf("Error: No se pudo agrandar la tabla de zombies\n");
+            return 0;
+        }
+        board->zombie_slots = slots;
+        board->zombie_slot_capacity = nueva_capacidad;
     }
 
-    // ===== 4. DETECTAR COLISIONES ARVEJA-ZOMBIE =====
-    for (int i = 0; i < MAX_ARVEJAS; i++) {
-        if (!board->arvejas[i].activo) continue;
-
-        int arveja_y_center = board->arvejas[i].rect.y + board->arvejas[i].rect.h / 2;
-        int arveja_row = (arveja_y_center - GRID_OFFSET_Y) / CELL_HEIGHT;
-        
-        if (arveja_row < 0 || arveja_row >= GRID_ROWS) continue;
+    ZombieBlock* block = malloc(sizeof(ZombieBlock) + faltan * sizeof(ZombieNode));
+    if (block == NULL) {
+        printf("Error: No se pudo asignar memoria para los zombies\n");
+        return 0;
+    }
+    block->next = board->zombie_blocks;
+    board->zombie_blocks = block;
+
+    // Encadeno los nodos nuevos en la lista de libres (reutilizo 'next')
+    // y les asigno su slot (los nodos nunca se mueven de su bloque)
+    for (int i = 0; i < faltan; i++) {
+        ZombieNode* nodo = &block->nodes[i];
+        nodo->slot = board->zombie_slot_count;
+        nodo->generation = 0;
+        board->zombie_slots[board->zombie_slot_count++] = nodo;
+
+        nodo->next = board->free_zombies;
+        board->free_zombies = nodo;
+    }
+    board->free_zombie_count += faltan;
+    return 1;
+}
 
-        ZombieNode* z_node = board->rows[arveja_row].first_zombie;
-        while (z_node != NULL) {
-            Zombie* z = &z_node->zombie_data;
-            
-            if (z->activo && SDL_HasIntersection(&board->arvejas[i].rect, &z->rect)) {
-                board->arvejas[i].activo = 0;
-                z->vida -= 25;
-                
-                if (z->vida <= 0) {
-                    z->activo = 0;
-                }
-                break;
-            }
-            z_node = z_node->next;
+/**
+ * Asegura lugar al final del índice ordenado de la fila para 'cantidad'
+ * zombies más. Los que mueren adelante dejan lugares libres al principio
+ * (inicio_zombies avanza), así que primero se corre todo al principio y
+ * solo si igual no alcanza se agranda, duplicando como el bucket de arvejas.
+ */
+static int reservarIndiceZombies(GardenRow* fila, int cantidad) {
+    int necesaria = fila->zombies_activos + cantidad;
+    if (fila->inicio_zombies + necesaria <= fila->capacidad_zombies) {
+        return 1;
+    }
+    if (fila->inicio_zombies > 0) {
+        for (int k = 0; k < fila->zombies_activos; k++) {
+            fila->zombies_por_x[k] = fila->zombies_por_x[fila->inicio_zombies + k];
+            fila->zombies_por_x[k]->pos_en_fila = k;
         }
+        fila->inicio_zombies = 0;
     }
-
-    // ===== 5. GENERAR NUEVOS ZOMBIES =====
-    generarZombieSiNecesario(board);
+    if (necesaria <= fila->capacidad_zombies) {
+        return 1;
+    }
+    int nueva_capacidad = fila->capacidad_zombies > 0 ? fila->capacidad_zombies * 2 : 16;
+    if (nueva_capacidad < necesaria) {
+        nueva_capacidad = necesaria;
+    }
+    ZombieNode** indice = realloc(fila->zombies_por_x, nueva_capacidad * sizeof(ZombieNode*));
+    if (indice == NULL) {
+        printf("Error: No se pudo agrandar el indice de zombies\n");
+        return 0;
+    }
+    fila->zombies_por_x = indice;
+    fila->capacidad_zombies = nueva_capacidad;
+    return 1;
 }
 
+/**
+ * Saca un nodo de la lista de libres (O(1)).
+ * Antes hay que llamar a reservarZombies para asegurar que haya.
+ */
+static ZombieNode* tomarZombieLibre(GameBoard* board) {
+    ZombieNode* node = board->free_zombies;
+    board->free_zombies = node->next;
+    board->free_zombie_count--;
+    return node;
+}
 
-
-
-// ========= GAME BOARD DRAW ==========
-
+/**
+ * Inicializa los datos de un zombie nuevo en la fila y posición dadas.
+ * 'pos_x' viene en punto fijo 16.16 y 'tick' es el tick actual del board
+ * (la animación arranca en el frame 0 ahí).
+ */
+static void initZombie(Zombie* z, int row, int pos_x, int tick) {
+    z->row = row;
+    z->pos_x = pos_x;
+    z->rect.x = FX_TO_INT(z->pos_x);
+    
+    // Ajuste para que el rect se ajuste al tamaño de la celda (como en el original)
+    z->rect.y = GRID_OFFSET_Y + (row * CELL_HEIGHT);
+    
+    // Dimensiones ajustadas a la celda para escalado automático en render
+    z->rect.w = CELL_WIDTH;
+    z->rect.h = CELL_HEIGHT;
+    
+    // Valores iniciales estándar
+    z->vida = 100;
+    z->activo = 1;
+    z->tick_spawn = tick;
+}
 
 /**
- * Dibuja el estado actual del juego en la pantalla.
- * Esta función implementa la lógica de la consigna,
- * adaptando la función 'dibujar' del juego base a las nuevas
- * estructuras de listas enlazadas.
+ * Inserta en la fila una cadena ya armada de nodos (enlazados por 'next'
+ * y terminada en NULL), ordenada de mayor a menor pos_x.
  *
- * La idea principal es dibujar en "capas", de atrás hacia adelante:
- * 1. Fondo -> 2. Plantas -> 3. Arvejas -> 4. Zombies -> 5. UI (Cursor)
+ * La lista de cada fila se mantiene ordenada de mayor a menor pos_x:
+ * el primero es el de más atrás y el último (front_zombie) el de más
+ * adelante. Como todos caminan igual, el orden no cambia al moverse, y
+ * como los zombies spawnean atrás de todo, insertar suele ser O(1): el
+ * lugar es el principio de la lista (igual que la inserción original).
+ * Entre zombies con la misma pos_x, el nuevo queda primero (LIFO).
+ * También los agrega al índice ordenado de la fila (zombies_por_x), que
+ * tiene que tener lugar de antes (ver reservarIndiceZombies), y en modo
+ * eventos revisa las arvejas que ahora pueden chocar antes.
  */
-void gameBoardDraw(GameBoard* board) {
-    // Validaciones básicas
-    if (board == NULL || renderer == NULL) {
-        return;
+static void engancharZombies(GameBoard* board, int row, ZombieNode* cadena) {
+    GardenRow* fila = &board->rows[row];
+    ZombieNode* anterior = NULL;
+    ZombieNode* pos = fila->first_zombie;
+
+    // En el índice ordenado (de menor a mayor x) se hace el mismo merge
+    // pero desde el final, llenando de atrás para adelante: 'viejo' es el
+    // último zombie que ya estaba y 'escribir' el lugar libre más atrás
+    int viejo = fila->inicio_zombies + fila->zombies_activos - 1;
+    for (ZombieNode* n = cadena; n != NULL; n = n->next) {
+        fila->zombies_activos++;
     }
+    int escribir = fila->inicio_zombies + fila->zombies_activos - 1;
 
-    // 1. Limpiar el frame anterior
-    SDL_RenderClear(renderer);
+    ZombieNode* nodo = cadena;
+    while (nodo != NULL) {
+        ZombieNode* siguiente = nodo->next; // Guardo el resto de la cadena
 
-    // 2. Dibujar el fondo
-    if (tex_background != NULL) {
-        SDL_RenderCopy(renderer, tex_background, NULL, NULL);
-    }
+        // Avanzo hasta el primer zombie que no esté más atrás que 'nodo'.
+        // La cadena viene ordenada, así que 'pos' nunca retrocede.
+        while (pos != NULL && pos->zombie_data.pos_x > nodo->zombie_data.pos_x) {
+            anterior = pos;
+            pos = pos->next;
+        }
 
-    // 3. DIBUJAR PLANTAS
-    // Recorro las 5 filas
-    for (int r = 0; r < GRID_ROWS; r++) {
-        // Recorro la lista de segmentos de cada fila
-        RowSegment* seg = board->rows[r].first_segment;
-        while (seg != NULL) {
-            // Si el segmento es una planta y está activa, la dibujo
-            if (seg->status == STATUS_PLANTA && seg->planta_data != NULL) {
-                Planta* p = seg->planta_data;
-                if (p->activo) {
-                    // Calculo el 'src_rect' para tomar el cuadro de animación correcto
-                    // de la hoja de sprites (sprite sheet).
-                    SDL_Rect src_rect = {
-                        p->current_frame * PEASHOOTER_FRAME_WIDTH,
-                        0,
-                        PEASHOOTER_FRAME_WIDTH,
-                        PEASHOOTER_FRAME_HEIGHT
-                    };
-                    SDL_RenderCopy(renderer, tex_peashooter_sheet, &src_rect, &p->rect);
-                }
-            }
-            seg = seg->next;
+        // Inserto 'nodo' entre 'anterior' y 'pos'
+        nodo->prev = anterior;
+        nodo->next = pos;
+        if (anterior == NULL) {
+            fila->first_zombie = nodo;
+        } else {
+            anterior->next = nodo;
+        }
+        if (pos == NULL) {
+            fila->front_zombie = nodo; // Quedó último: es el de más adelante
+        } else {
+            pos->prev = nodo;
         }
-    }
 
-    // 4. DIBUJAR ARVEJAS
-    // (Las arvejas siguen en un array estático)
-    if (tex_pea != NULL) {
-        for (int i = 0; i < MAX_ARVEJAS; i++) {
-            if (board->arvejas[i].activo) {
-                // El 'src_rect' es NULL porque 'pea.png' no es una hoja de sprites
-                SDL_RenderCopy(renderer, tex_pea, NULL, &board->arvejas[i].rect);
-            }
+        // Los zombies nuevos suelen ir atrás de todo, así que casi nunca
+        // hay que correr ninguno de los que ya estaban
+        while (viejo >= fila->inicio_zombies &&
+               fila->zombies_por_x[viejo]->zombie_data.pos_x > nodo->zombie_data.pos_x) {
+            fila->zombies_por_x[escribir] = fila->zombies_por_x[viejo--];
+            fila->zombies_por_x[escribir]->pos_en_fila = escribir;
+            escribir--;
         }
+        fila->zombies_por_x[escribir] = nodo;
+        nodo->pos_en_fila = escribir;
+        escribir--;
+
+        anterior = nodo;
+        if (siguiente == NULL && board->modo_eventos) {
+            // 'nodo' es el último de la cadena: el nuevo de más adelante
+            revisarArvejasAlcanzables(board, row, nodo->zombie_data.rect.x + nodo->zombie_data.rect.w);
+        }
+        nodo = siguiente;
     }
 
-    // 5. DIBUJAR ZOMBIES
-    // Recorro las 5 filas
-    for (int r = 0; r < GRID_ROWS; r++) {
-        // Recorro la lista de zombies de cada fila
-        ZombieNode* z_node = board->rows[r].first_zombie;
-        while (z_node != NULL) {
-            Zombie* z = &z_node->zombie_data;
-            if (z->activo) {
-                // Calculo el 'src_rect' para la animación del zombie
-                SDL_Rect src_rect = {
-                    z->current_frame * ZOMBIE_FRAME_WIDTH,
-                    0,
-                    ZOMBIE_FRAME_WIDTH,
-                    ZOMBIE_FRAME_HEIGHT
-                };
-                SDL_RenderCopy(renderer, tex_zombie_sheet, &src_rect, &z->rect);
-            }
-            z_node = z_node->next;
-        }
+    board->filas_con_zombies |= 1 << row;
+
+    // Las plantas que esperaban zombies en esta fila ya tienen a quién disparar
+    if (fila->plantas_esperando != NULL) {
+        despertarPlantas(board, row);
     }
+    despertarPlantasConAlcance(board, row);
+}
 
-    // 6. DIBUJAR CURSOR (UI)
-    // Es importante guardar y restaurar el color de dibujo
-    // para no afectar otros elementos de la UI.
-    Uint8 r, g, b, a;
-    SDL_GetRenderDrawColor(renderer, &r, &g, &b, &a); // Guardo color
+/**
+ * Crea un nuevo zombie (ZombieNode) con memoria dinámica y lo
+ * agrega a la lista enlazada de la fila correspondiente.
+ *
+ * Esta función resuelve la limitación del array estático del juego base,
+ * permitiendo un número virtualmente ilimitado de zombies.
+ * La idea principal es usar la inserción al principio de la lista (O(1)),
+ * que es la forma más eficiente de agregar un nodo.
+ */
+void gameBoardAddZombie(GameBoard* board, int row) {
+    // Validación: chequeo de puntero NULL e índice de fila
+    if (board == NULL) {
+        printf("Error: Board es NULL en gameBoardAddZombie\n");
+        return;
+    }
+    if (row < 0 || row >= GRID_ROWS) {
+        printf("Error: Row %d inválida (debe ser 0-%d) en gameBoardAddZombie\n", 
+               row, GRID_ROWS - 1);
+        return;
+    }
     
-    SDL_SetRenderDrawColor(renderer, 255, 255, 0, 200); // Amarillo
-    SDL_Rect cursor_rect = {
-        GRID_OFFSET_X + (cursor.col * CELL_WIDTH),
-        GRID_OFFSET_Y + (cursor.row * CELL_HEIGHT),
-        CELL_WIDTH,
-        CELL_HEIGHT
-    };
-    SDL_RenderDrawRect(renderer, &cursor_rect);
+    // 1. Tomo un nodo del pool del board (el "contenedor")
+    if (!reservarZombies(board, 1) || !reservarIndiceZombies(&board->rows[row], 1)) {
+        return;
+    }
+    ZombieNode* nuevo_nodo = tomarZombieLibre(board);
     
-    SDL_SetRenderDrawColor(renderer, r, g, b, a); // Restauro color
-
-    // 7. Muestro el frame terminado en la pantalla
-    SDL_RenderPresent(renderer);
+    // 2. Inicializo los datos del zombie (el "contenido")
+    initZombie(&nuevo_nodo->zombie_data, row, INT_TO_FX(SCREEN_WIDTH), board->tick); // Spawnea fuera de pantalla
+    
+    // 3. Agrego el nodo a la lista. Spawnea atrás de todo, así que queda
+    //    al PRINCIPIO de la lista (Head Insertion, O(1))
+    nuevo_nodo->next = NULL;
+    engancharZombies(board, row, nuevo_nodo);
 }
 
 
+//======== GAME BOARD ADD ZOMBIES ==========
 
-//=========== STR DUPLICATE ===========
 /**
- * Duplica un string en una nueva área de memoria.
- * La idea es calcular la longitud de src, pedir memoria con malloc
- * (longitud + 1 para el '\0') y copiar todo el contenido.
- * Esto resuelve el problema de necesitar copias independientes.
+ * Indica si una oleada de 'count' zombies separados 'spacing' píxeles
+ * entra en el rango del punto fijo 16.16: el de más atrás spawnea en
+ * SCREEN_WIDTH + (count - 1) * spacing y no puede pasar de FX_MAX_PX.
  */
-char* strDuplicate(char* src) {
-    // Valido la entrada
-    if (src == NULL) {
-        return NULL;  
+static int oleadaEntraEnRango(int count, int spacing) {
+    return spacing <= 0 || count - 1 <= (FX_MAX_PX - SCREEN_WIDTH) / spacing;
+}
+
+/**
+ * Agrega 'count' zombies de una sola vez en una fila (oleadas y banderas).
+ * El primero spawnea en SCREEN_WIDTH y cada uno de los siguientes
+ * 'spacing' píxeles más atrás.
+ *
+ * Hacerlo con gameBoardAddZombie en un loop traba el frame, así que acá:
+ * 1. Se reserva la memoria una sola vez (un bloque para toda la oleada).
+ * 2. Se inicializan los zombies en un loop simple, armando la cadena.
+ * 3. Se engancha la cadena entera en la fila de una vez.
+ * El resultado es el mismo que llamar a gameBoardAddZombie 'count' veces
+ * (el último zombie, el de más atrás, queda primero en la lista).
+ * Devuelve la cantidad de zombies agregados.
+ */
+int gameBoardAddZombies(GameBoard* board, int row, int count, int spacing) {
+    // ===== VALIDACIONES =====
+    if (board == NULL) {
+        printf("Error: Board es NULL en gameBoardAddZombies\n");
+        return 0;
+    }
+    if (row < 0 || row >= GRID_ROWS) {
+        printf("Error: Row %d invalida en gameBoardAddZombies\n", row);
+        return 0;
+    }
+    if (count <= 0 || spacing < 0) {
+        return 0;
+    }
+    if (!oleadaEntraEnRango(count, spacing)) {
+        printf("Error: Oleada demasiado larga en gameBoardAddZombies\n");
+        return 0;
     }
 
-    //Calculo la longitud de src
-    size_t len = 0;
-    while (src[len] != '\0') {
-        len++;
+    // 1. Reservo todos los nodos (y su lugar en el índice) de una vez
+    if (!reservarZombies(board, count) || !reservarIndiceZombies(&board->rows[row], count)) {
+        return 0;
     }
 
-    // Asigno memoria para el nuevo string (longitud + 1)
-    char* nuevo = malloc(len + 1);  
-    if (nuevo == NULL) {    // Fallo en malloc
-        return NULL;
+    // 2. Inicializo y armo la cadena. Voy insertando cada uno adelante
+    //    del anterior, así queda ordenada de mayor a menor pos_x.
+    ZombieNode* cadena = NULL;
+    for (int i = 0; i < count; i++) {
+        ZombieNode* nodo = tomarZombieLibre(board);
+        initZombie(&nodo->zombie_data, row, INT_TO_FX(SCREEN_WIDTH + i * spacing), board->tick);
+        nodo->next = cadena;
+        cadena = nodo;
     }
 
-    // Copio el contenido de src a nuevo, incluyendo el '\0'
-    for (size_t i = 0; i <= len; i++) {  
-        nuevo[i] = src[i];
-    }
-    return nuevo;
+    // 3. Engancho la cadena completa
+    engancharZombies(board, row, cadena);
+    return count;
 }
 
 
-//=========== STR COMPARE ===========
 /**
- * Compara dos strings lexicográficamente (orden ASCII).
- * Resuelve la necesidad de ordenar o comparar strings siguiendo
- * las reglas de la consigna:
- * 0 si son iguales,
- * 1 si s1 < s2,
- * -1 si s1 > s2.
+ * Saca un zombie de la lista de su fila y devuelve el nodo al pool.
+ * Gracias al puntero 'prev' no hace falta recorrer la lista buscando
+ * al anterior: se reconectan los vecinos directamente en O(1).
+ * Se usa apenas un zombie muere, así los zombies muertos no quedan
+ * ocupando la lista que recorren el update, el draw y el game over.
  */
-int strCompare(char* s1, char* s2) {
-    // Manejo robusto de casos NULL
-    if (s1 == NULL && s2 == NULL) return 0; // Iguales
-    if (s1 == NULL) return 1;  // NULL se considera "menor"
-    if (s2 == NULL) return -1; // "mayor" que NULL
-    
-    // Itero hasta encontrar la primera diferencia o el fin de un string
-    size_t i = 0;
-    while (s1[i] != '\0' && s2[i] != '\0' && s1[i] == s2[i]) {
-        i++;
-    }
-    
-    // Analizo el carácter donde frenó
-    if (s1[i] == s2[i]) {
-        return 0;  // Son iguales (ambos llegaron a '\0')
-    } else if ((unsigned char)s1[i] < (unsigned char)s2[i]) {
-        return 1;  // s1 es menor
+static void removeZombieNode(GameBoard* board, int row, ZombieNode* node) {
+    if (node->prev == NULL) {
+        board->rows[row].first_zombie = node->next;
     } else {
-        return -1; // s1 es mayor
+        node->prev->next = node->next;
+    }
+    if (node->next != NULL) {
+        node->next->prev = node->prev;
+    }
+    // Si era el de más adelante, el nuevo es su anterior (la lista está ordenada)
+    if (board->rows[row].front_zombie == node) {
+        board->rows[row].front_zombie = node->prev;
+    }
+    // En el índice se corren un lugar los que estaban más adelante. Casi
+    // siempre muere el de más adelante, y ahí no hay que correr ninguno.
+    GardenRow* fila = &board->rows[row];
+    for (int k = node->pos_en_fila; k > fila->inicio_zombies; k--) {
+        fila->zombies_por_x[k] = fila->zombies_por_x[k - 1];
+        fila->zombies_por_x[k]->pos_en_fila = k;
+    }
+    fila->inicio_zombies++;
+    fila->zombies_activos--;
+    if (fila->zombies_activos == 0) {
+        fila->inicio_zombies = 0;
+        board->filas_con_zombies &= ~(1 << row);
     }
+
+    // Devuelvo el nodo al pool en lugar de liberarlo. Cambiar la generación
+    // vence todos los handles que apuntaban a este zombie.
+    node->generation++;
+    node->next = board->free_zombies;
+    board->free_zombies = node;
+    board->free_zombie_count++;
 }
 
 
-//=========== STR CONCATENATE ================
+
+
+
+// ========= GAME BOARD ZOMBIE HANDLES ==========
+
 /**
- * Concatena dos strings (src1 y src2) en uno nuevo.
- * La idea es calcular las longitudes, pedir memoria para la suma
- * de ambas (más el '\0') y copiar ambos contenidos.
- * Resuelve el requisito de la consigna de liberar la memoria
- * de los strings originales.
+ * Devuelve un handle estable (slot + generación) para un zombie vivo.
+ * A diferencia del puntero al nodo, el handle se puede guardar entre
+ * ticks (proyectiles dirigidos, IA, interpolación del render): si el
+ * zombie muere, gameBoardGetZombie lo detecta y devuelve NULL.
  */
-char* strConcatenate(char* src1, char* src2) {
-    // Calcular longitudes de src1 y src2, manejando NULLs
-    size_t len1 = 0;
-    if (src1 != NULL) {
-        while (src1[len1] != '\0') len1++;
-    }
-    size_t len2 = 0;
-    if (src2 != NULL) {
-        while (src2[len2] != '\0') len2++;
+ZombieHandle gameBoardGetZombieHandle(ZombieNode* node) {
+    ZombieHandle handle = {-1, 0};
+    if (node != NULL) {
+        handle.index = node->slot;
+        handle.generation = node->generation;
     }
+    return handle;
+}
 
-    // Asignar memoria para el string resultante
-    char* resultado = malloc(len1 + len2 + 1);
-    
-    // Si falla malloc, libero la memoria original (como pide la consigna)
-    if (resultado == NULL) {
-        free(src1);  
-        free(src2);
+/**
+ * Busca el zombie de un handle en O(1) usando la tabla de slots.
+ * Devuelve NULL si el handle es inválido o está vencido (el zombie
+ * murió y su nodo volvió al pool, aunque ya lo use otro zombie).
+ */
+ZombieNode* gameBoardGetZombie(GameBoard* board, ZombieHandle handle) {
+    if (board == NULL || handle.index < 0 || handle.index >= board->zombie_slot_count) {
         return NULL;
     }
-
-    // Copio src1 en resultado
-    size_t i = 0;
-    if (src1 != NULL) {
-        for (; i < len1; i++) {
-            resultado[i] = src1[i];
-        }
+    ZombieNode* node = board->zombie_slots[handle.index];
+    if (node->generation != handle.generation) {
+        return NULL; // Handle vencido
     }
+    return node;
+}
 
-    // Copio src2 a continuación
-    size_t j = 0;
-    if (src2 != NULL) {
-        for (; j < len2; j++, i++) {
-            resultado[i] = src2[j];
+
+
+
+
+
+// ========= GAME BOARD NEAREST ZOMBIE ==========
+
+/**
+ * Busca, en el índice ordenado de la fila, el primer zombie que todavía
+ * no quedó entero a la izquierda de 'x' (su borde derecho está pasando x).
+ * Todos los zombies tienen el mismo ancho, así que ordenar por x también
+ * ordena el borde derecho y alcanza con una búsqueda binaria: O(log n).
+ */
+static ZombieNode* buscarZombieAdelante(GardenRow* fila, int x) {
+    int lo = fila->inicio_zombies;
+    int hi = fila->inicio_zombies + fila->zombies_activos;
+    while (lo < hi) {
+        int mitad = lo + (hi - lo) / 2;
+        Zombie* z = &fila->zombies_por_x[mitad]->zombie_data;
+        if (z->rect.x + z->rect.w <= x) {
+            lo = mitad + 1;
+        } else {
+            hi = mitad;
         }
     }
-    // Termino el nuevo string
-    resultado[i] = '\0';
+    return lo < fila->inicio_zombies + fila->zombies_activos ? fila->zombies_por_x[lo] : NULL;
+}
 
-    // Libero la memoria de los strings originales (consigna)
-    free(src1);
-    free(src2);
-    return resultado;
+/**
+ * Devuelve el zombie activo más cercano a la derecha de 'x' en la fila
+ * (el primero que encontraría algo que sale desde 'x' hacia la derecha),
+ * o NULL si no hay ninguno. Sirve para que las plantas decidan si disparar
+ * sin recorrer la lista de zombies: se responde con el índice ordenado.
+ */
+ZombieNode* gameBoardNearestZombieAhead(GameBoard* board, int row, int x) {
+    if (board == NULL) {
+        printf("Error: Board es NULL en gameBoardNearestZombieAhead\n");
+        return NULL;
+    }
+    if (row < 0 || row >= GRID_ROWS) {
+        printf("Error: Row %d invalida en gameBoardNearestZombieAhead\n", row);
+        return NULL;
+    }
+    return buscarZombieAdelante(&board->rows[row], x);
 }
 
 
 
 
-// ========== TESTS STR DUPLICATE ==========
 
 
+// ========= GAME BOARD COMANDOS ==========
+
 /**
- * Pruebas para strDuplicate.
- * El objetivo es validar que la copia funcione en casos borde
- * (vacío, NULL) y que la copia sea independiente en memoria.
+ * Encola un cambio al board para que lo aplique la simulación al empezar
+ * el próximo gameBoardUpdate. Sirve para que el input corra en otro hilo
+ * que la simulación: es la única función del board que se puede llamar
+ * desde el hilo del input mientras otro hilo hace el update, y tiene que
+ * ser siempre el mismo hilo (un solo productor).
+ * No usa locks: escribe el comando en su lugar y recién después lo
+ * publica aumentando 'escritos'.
+ * Devuelve 1 si lo encoló, 0 si la cola está llena o el comando es inválido.
  */
-void testStrDuplicate() {
-    printf("\n========= TESTS strDuplicate =========\n");
-    
-    // TEST 1: Pruebo el caso base: un string vacío
-    char* test1_src = "";
-    char* test1_dup = strDuplicate(test1_src);
-    if (test1_dup != NULL && test1_dup[0] == '\0') {
-        printf("✓ TEST 1 PASADO: String vacio duplicado correctamente\n");
-    } else {
-        printf("✗ TEST 1 FALLADO: String vacio no duplicado correctamente\n");
+int gameBoardPushCommand(GameBoard* board, int tipo, int row, int col) {
+    if (board == NULL) {
+        printf("Error: Board NULL en gameBoardPushCommand\n");
+        return 0;
     }
-    free(test1_dup);
-    
-    // TEST 2: Pruebo el caso mínimo con contenido
-    char* test2_src = "A";
-    char* test2_dup = strDuplicate(test2_src);
-    if (test2_dup != NULL && test2_dup[0] == 'A' && test2_dup[1] == '\0') {
-        printf("✓ TEST 2 PASADO: String de un caracter duplicado correctamente\n");
-    } else {
-        printf("✗ TEST 2 FALLADO: String de un caracter no duplicado correctamente\n");
+    if (tipo != COMANDO_PLANTAR && tipo != COMANDO_SACAR_PLANTA && tipo != COMANDO_ZOMBIE) {
+        printf("Error: Comando desconocido (%d)\n", tipo);
+        return 0;
     }
-    free(test2_dup);
-    
-    // TEST 3: Pruebo un string normal
-    char* test3_src = "Hola Mundo 123!";
-    char* test3_dup = strDuplicate(test3_src);
-    int test3_ok = 1;
-    if (test3_dup == NULL) {
-        test3_ok = 0;
-    } else {
-        // Verifico contenido y terminador
-        int i = 0;
-        while (test3_src[i] != '\0') {
-            if (test3_dup[i] != test3_src[i]) {
-                test3_ok = 0;
-                break;
-            }
-            i++;
-        }
-        if (test3_dup[i] != '\0') {
-            test3_ok = 0;
+
+    ColaComandos* cola = &board->comandos;
+    int escritos = SDL_AtomicGet(&cola->escritos);
+    if (escritos - SDL_AtomicGet(&cola->leidos) == COLA_COMANDOS) {
+        return 0; // Llena: la simulación todavía no aplicó los anteriores
+    }
+
+    Comando* c = &cola->comandos[escritos & (COLA_COMANDOS - 1)];
+    c->tipo = tipo;
+    c->row = row;
+    c->col = col;
+    SDL_MemoryBarrierRelease(); // El comando queda escrito antes de publicarlo
+    SDL_AtomicSet(&cola->escritos, escritos + 1);
+    return 1;
+}
+
+/**
+ * Aplica un comando con la función pública que corresponde (que valida
+ * la fila y la columna como siempre).
+ */
+static void aplicarComando(GameBoard* board, const Comando* c) {
+    switch (c->tipo) {
+        case COMANDO_PLANTAR:
+            gameBoardAddPlant(board, c->row, c->col);
+            break;
+        case COMANDO_SACAR_PLANTA:
+            gameBoardRemovePlant(board, c->row, c->col);
+            break;
+        case COMANDO_ZOMBIE:
+            gameBoardAddZombie(board, c->row);
+            break;
+    }
+}
+
+/**
+ * Aplica, en orden, los comandos que ya estaban publicados al empezar.
+ * Los que lleguen mientras tanto quedan para el próximo tick, así un
+ * input muy rápido no puede frenar la simulación. Cada lugar se libera
+ * (aumentando 'leidos') apenas se aplica su comando.
+ */
+static void procesarComandos(GameBoard* board) {
+    ColaComandos* cola = &board->comandos;
+    int leidos = SDL_AtomicGet(&cola->leidos);
+    int escritos = SDL_AtomicGet(&cola->escritos);
+    SDL_MemoryBarrierAcquire(); // Veo los comandos que se escribieron antes de publicarse
+    while (leidos != escritos) {
+        Comando c = cola->comandos[leidos & (COLA_COMANDOS - 1)];
+        leidos++;
+        SDL_AtomicSet(&cola->leidos, leidos);
+        aplicarComando(board, &c);
+    }
+}
+
+
+
+
+// ========= GAME BOARD UPDATE ==========
+
+/**
+ * Agrega el índice 'i' de una arveja al bucket de su fila.
+ * El bucket crece duplicando, igual que el array de arvejas, y se
+ * mantiene ordenado por x: la arveja nueva se corre hacia atrás
+ * mientras haya arvejas más adelantadas que ella. Como todas avanzan
+ * igual, el orden solo puede cambiar acá, al disparar.
+ */
+static int agregarArvejaAFila(GardenRow* fila, Arveja* arvejas, const int* xs, int i) {
+    if (fila->cant_arvejas == fila->capacidad_arvejas) {
+        int nueva_capacidad = fila->capacidad_arvejas > 0 ? fila->capacidad_arvejas * 2 : 16;
+        int* indices = realloc(fila->indices_arvejas, nueva_capacidad * sizeof(int));
+        if (indices == NULL) {
+            return 0;
         }
+        fila->indices_arvejas = indices;
+        fila->capacidad_arvejas = nueva_capacidad;
     }
-    if (test3_ok) {
-        printf("✓ TEST 3 PASADO: String con varios caracteres duplicado correctamente\n");
-    } else {
-        printf("✗ TEST 3 FALLADO: String con varios caracteres no duplicado correctamente\n");
+    int pos = fila->cant_arvejas++;
+    while (pos > 0 && xs[fila->indices_arvejas[pos - 1]] > xs[i]) {
+        int adelante = fila->indices_arvejas[pos - 1];
+        fila->indices_arvejas[pos] = adelante;
+        arvejas[adelante].pos_en_fila = pos;
+        pos--;
     }
-    free(test3_dup);
-    
-    // TEST 4: Pruebo todos los caracteres pedidos por la consigna
-    char* test4_src = "!@#$%^&*()_+-=[]{}|;:',.<>?/0123456789";
-    char* test4_dup = strDuplicate(test4_src);
-    int test4_ok = 1;
-    if (test4_dup == NULL) {
-        test4_ok = 0;
-    } else {
-        int i = 0;
-        while (test4_src[i] != '\0') {
-            if (test4_dup[i] != test4_src[i]) {
-                test4_ok = 0;
-                break;
-            }
-            i++;
+    arvejas[i].pos_en_fila = pos;
+    fila->indices_arvejas[pos] = i;
+    return 1;
+}
+
+/**
+ * Saca el índice de una arveja del bucket de su fila corriendo un lugar
+ * las que tiene adelante, así el bucket sigue ordenado por x.
+ * Las arvejas que salen de la pantalla son las más adelantadas (el final
+ * del bucket), así que para ellas es O(1); solo los impactos del modo
+ * eventos pueden sacar una del medio.
+ */
+static void sacarArvejaDeFila(GardenRow* fila, Arveja* arvejas, int i) {
+    for (int pos = arvejas[i].pos_en_fila; pos < fila->cant_arvejas - 1; pos++) {
+        int adelante = fila->indices_arvejas[pos + 1];
+        fila->indices_arvejas[pos] = adelante;
+        arvejas[adelante].pos_en_fila = pos;
+    }
+    fila->cant_arvejas--;
+}
+
+/**
+ * Helper para crear una nueva arveja.
+ * Las arvejas están compactas al principio del array, así que la nueva
+ * va directo al final (O(1)). Si no hay lugar, el array se agranda al
+ * doble; solo si eso falla el disparo se pierde (y queda contado en
+ * 'arvejas_descartadas').
+ * Como una arveja nunca cambia de fila, acá mismo se anota en el
+ * bucket de su fila para que la colisión no tenga que calcularla.
+ */
+static void dispararArveja(GameBoard* board, Planta* p, int row) {
+    // Solo disparar si hay zombies en la fila (O(1) con el contador)
+    if (board->rows[row].zombies_activos == 0) {
+        return;
+    }
+
+    if (board->cant_arvejas == board->arvejas_capacidad &&
+        !reservarArvejas(board, board->arvejas_capacidad * 2)) {
+        board->arvejas_descartadas++;
+        return;
+    }
+
+    int i = board->cant_arvejas;
+    board->arvejas_fila[i] = row;
+    board->arvejas_x[i] = INT_TO_FX(p->rect.x + (CELL_WIDTH / 2)); // Centrado
+    board->arvejas[i].pos_en_heap = -1;
+
+    // Con la posición ya cargada, la anoto ordenada en el bucket de su fila
+    if (!agregarArvejaAFila(&board->rows[row], board->arvejas, board->arvejas_x, i)) {
+        board->arvejas_descartadas++;
+        return;
+    }
+    board->filas_con_arvejas |= 1 << row;
+    board->cant_arvejas++;
+
+    // En modo eventos se calcula su impacto en la fase 4 de este mismo tick
+    if (board->modo_eventos) {
+        programarImpacto(board, i, board->tick);
+    }
+
+    if (board->cant_arvejas > board->arvejas_max_activas) {
+        board->arvejas_max_activas = board->cant_arvejas;
+    }
+}
+
+/**
+ * Saca la arveja 'i' del array manteniéndolo compacto (swap-remove):
+ * la última arveja pasa a ocupar el lugar 'i' (también en los arrays de
+ * posición y fila) y se corrige su índice en el bucket de su fila. No
+ * toca el bucket de la arveja 'i' (eso lo hace quien la llama).
+ */
+static void devolverSlotArveja(GameBoard* board, int i) {
+    desprogramarImpacto(board, i);
+    int ultima = --board->cant_arvejas;
+    if (i != ultima) {
+        board->arvejas[i] = board->arvejas[ultima];
+        board->arvejas_x[i] = board->arvejas_x[ultima];
+        board->arvejas_fila[i] = board->arvejas_fila[ultima];
+        if (board->arvejas[i].pos_en_fila >= 0) { // -1: ya la sacaron del bucket
+            GardenRow* fila = &board->rows[board->arvejas_fila[i]];
+            fila->indices_arvejas[board->arvejas[i].pos_en_fila] = i;
         }
-        if (test4_dup[i] != '\0') {
-            test4_ok = 0;
+        if (board->arvejas[i].pos_en_heap >= 0) {
+            board->impactos[board->arvejas[i].pos_en_heap] = i;
         }
     }
-    if (test4_ok) {
-        printf("✓ TEST 4 PASADO: String con caracteres especiales duplicado correctamente\n");
-    } else {
-        printf("✗ TEST 4 FALLADO: String con caracteres especiales no duplicado correctamente\n");
+}
+
+/**
+ * Saca la arveja 'i' del bucket de su fila y del array.
+ * Ojo: después de llamarla, en 'i' queda otra arveja (la que era la última).
+ */
+static void liberarArveja(GameBoard* board, int i) {
+    int row = board->arvejas_fila[i];
+    sacarArvejaDeFila(&board->rows[row], board->arvejas, i);
+    if (board->rows[row].cant_arvejas == 0) {
+        board->filas_con_arvejas &= ~(1 << row);
     }
-    free(test4_dup);
-    
-    // TEST 5: Pruebo la independencia de la memoria.
-    // Modifico la copia y verifico que el original no cambie.
-    char* test5_src = "Test";
-    char* test5_dup = strDuplicate(test5_src);
-    if (test5_dup != NULL && test5_dup != test5_src) {
-        test5_dup[0] = 'X'; // Modifico la copia
-        if (test5_src[0] == 'T' && test5_dup[0] == 'X') {
-            printf("✓ TEST 5 PASADO: El duplicado es independiente del original\n");
-        } else {
-            printf("✗ TEST 5 FALLADO: El duplicado no es independiente\n");
+    devolverSlotArveja(board, i);
+}
+
+/**
+ * Mueve 'cantidad' arvejas un tick, de a una. Es un loop sin ramas sobre
+ * los arrays de posición y fila: cada arveja solo se suma la velocidad, y
+ * en la misma pasada se arma la máscara de filas que tienen alguna arveja
+ * fuera de la pantalla (bit r = fila r). Así el loop caliente no saca
+ * arvejas (lo que reordena el array) ni tiene un if por arveja.
+ * Es la versión de respaldo de avanzarArvejas, y la que mueve la cola
+ * que no llena un bloque.
+ */
+static int avanzarArvejasEscalar(int* xs, const int* filas, int cantidad) {
+    int filas_con_salidas = 0;
+    for (int i = 0; i < cantidad; i++) {
+        xs[i] += PEA_SPEED_FX;
+        filas_con_salidas |= (FX_TO_INT(xs[i]) > SCREEN_WIDTH) << filas[i];
+    }
+    return filas_con_salidas;
+}
+
+/**
+ * Mueve 'cantidad' arvejas un tick y devuelve la máscara de filas con
+ * salidas, igual que avanzarArvejasEscalar. Con SSE2 las x (contiguas en
+ * su propio array) se mueven de a bloques de 4: una suma y una
+ * comparación contra el borde por bloque, y movemask dice qué arvejas del
+ * bloque salieron. Que salga una es raro (una vez por arveja en toda su
+ * vida), así que recién ahí se leen sus filas. El resto que no llena un
+ * bloque va por el loop escalar.
+ */
+static int avanzarArvejas(int* xs, const int* filas, int cantidad) {
+    int filas_con_salidas = 0;
+    int i = 0;
+#ifdef __SSE2__
+    const __m128i velocidad = _mm_set1_epi32(PEA_SPEED_FX);
+    // FX_TO_INT(x) > SCREEN_WIDTH  <=>  x > INT_TO_FX(SCREEN_WIDTH + 1) - 1
+    const __m128i borde = _mm_set1_epi32(INT_TO_FX(SCREEN_WIDTH + 1) - 1);
+    for (; i + 4 <= cantidad; i += 4) {
+        __m128i x = _mm_add_epi32(_mm_loadu_si128((const __m128i*)&xs[i]), velocidad);
+        _mm_storeu_si128((__m128i*)&xs[i], x);
+        int salen = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpgt_epi32(x, borde)));
+        for (int k = 0; salen != 0; k++, salen >>= 1) {
+            filas_con_salidas |= (salen & 1) << filas[i + k];
         }
+    }
+#endif
+    return filas_con_salidas | avanzarArvejasEscalar(&xs[i], &filas[i], cantidad - i);
+}
+
+/**
+ * Saca las arvejas de la fila que salieron de la pantalla. El bucket está
+ * ordenado por x, así que son las últimas: se sacan desde el final hasta
+ * encontrar una que siga en pantalla, sin mirar el resto de la fila.
+ */
+static void sacarArvejasFueraDePantalla(GameBoard* board, int row) {
+    GardenRow* fila = &board->rows[row];
+    while (fila->cant_arvejas > 0) {
+        int i = fila->indices_arvejas[fila->cant_arvejas - 1];
+        if (xDeArveja(board, i) <= SCREEN_WIDTH) {
+            break;
+        }
+        liberarArveja(board, i);
+    }
+}
+
+/**
+ * Kernel de colisión arveja-zombie para la MISMA fila.
+ * Reemplaza a SDL_HasIntersection en el chequeo de colisiones: en una
+ * fila, el rango vertical de la arveja (y + CELL_HEIGHT/4, alto 20) cae
+ * siempre dentro del del zombie (y, alto CELL_HEIGHT), así que lo único
+ * que puede no superponerse es el rango en x. Con anchos positivos, esto
+ * da exactamente lo mismo que SDL_HasIntersection, pero sin llamar a la
+ * librería ni revisar el eje y.
+ */
+static inline int arvejaTocaZombie(const SDL_Rect* arveja, const SDL_Rect* zombie) {
+    return arveja->x < zombie->x + zombie->w && zombie->x < arveja->x + arveja->w;
+}
+
+/**
+ * Completa el golpe 'g' de la arveja 'i' contra el zombie de 'z_node'.
+ */
+static void llenarGolpe(GameBoard* board, Golpe* g, int i, int row, ZombieNode* z_node) {
+    g->arveja = i;
+    g->fila = row;
+    g->x = xDeArveja(board, i);
+    g->zombie = gameBoardGetZombieHandle(z_node);
+    g->dano = PEA_DAMAGE;
+}
+
+/**
+ * Anota un golpe en el buffer del tick. Nunca se llena: tiene un lugar
+ * por arveja y cada arveja impacta como mucho una vez.
+ */
+static void anotarGolpe(GameBoard* board, int i, int row, ZombieNode* z_node) {
+    llenarGolpe(board, &board->golpes[board->cant_golpes++], i, row, z_node);
+}
+
+/**
+ * Detección de colisiones (sort-and-sweep) de una fila: las arvejas
+ * (bucket) y los zombies (lista) ya están ordenados por x, así que se
+ * recorren juntos una sola vez, como en un merge: O(arvejas + zombies)
+ * en lugar de O(arvejas * zombies). Las filas sin zombies o sin arvejas
+ * se saltean enteras.
+ * No modifica nada fuera de su fila: anota los golpes en su tramo del
+ * buffer. Para saber qué arveja le pega a cuál, lleva la cuenta del daño
+ * que ya recibió el zombie actual en este tick; cuando lo mataría, sigue
+ * con el de atrás, igual que si el daño se aplicara en el momento.
+ * Es un trabajo de una fila entera: 'desde' y 'hasta' no se usan.
+ */
+static void detectarColisionesDeFila(GameBoard* board, int r, int desde, int hasta) {
+    GardenRow* fila = &board->rows[r];
+    Golpe* golpes = &board->golpes[fila->primer_golpe];
+
+    // Los zombies se recorren de adelante hacia atrás (de menor a mayor x)
+    ZombieNode* z_node = fila->front_zombie;
+    int dano = 0; // Daño anotado en este tick para z_node
+
+    for (int k = 0; k < fila->cant_arvejas; k++) {
+        int i = fila->indices_arvejas[k];
+        SDL_Rect a = rectDeArveja(board, i);
+
+        // Descarto los zombies que quedaron enteros a la izquierda de la
+        // arveja: tampoco los puede tocar ninguna de las siguientes, que
+        // están más a la derecha. (Todos los zombies tienen el mismo
+        // ancho, así que ordenar por x también ordena el borde derecho.)
+        while (z_node != NULL &&
+               z_node->zombie_data.rect.x + z_node->zombie_data.rect.w <= a.x) {
+            z_node = z_node->prev;
+            dano = 0;
+        }
+
+        // El zombie actual es el primero que la arveja encuentra en su
+        // camino: si no la toca, ninguno de los de más atrás tampoco.
+        // Cada arveja impacta como mucho a un zombie.
+        if (z_node != NULL && z_node->zombie_data.activo &&
+            arvejaTocaZombie(&a, &z_node->zombie_data.rect)) {
+            llenarGolpe(board, &golpes[fila->cant_golpes++], i, r, z_node);
+            dano += PEA_DAMAGE;
+            if (z_node->zombie_data.vida - dano <= 0) {
+                // Con este golpe muere: las siguientes ya le pegan al de atrás
+                z_node = z_node->prev;
+                dano = 0;
+            }
+        }
+    }
+}
+
+/**
+ * Detección de colisiones de todas las filas. Cada fila anota en su
+ * propio tramo del buffer de golpes (tiene lugar para una por arveja de
+ * la fila), así las filas se pueden detectar en paralelo: un trabajo por
+ * fila, porque el merge de una fila va en orden. Después los
+ * tramos se juntan en orden de filas: el buffer queda igual que si se
+ * hubieran detectado de a una.
+ */
+static void detectarColisiones(GameBoard* board) {
+    int inicio = 0;
+    for (int r = 0; r < GRID_ROWS; r++) {
+        board->rows[r].primer_golpe = inicio;
+        board->rows[r].cant_golpes = 0;
+        inicio += board->rows[r].cant_arvejas;
+    }
+
+    int filas = board->filas_con_zombies & board->filas_con_arvejas;
+    for (int r = 0; r < GRID_ROWS; r++) {
+        if (filas & (1 << r)) {
+            encolarTrabajo(board, detectarColisionesDeFila, r, 0, 0);
+        }
+    }
+    esperarTrabajos(board);
+
+    for (int r = 0; r < GRID_ROWS; r++) {
+        GardenRow* fila = &board->rows[r];
+        for (int g = 0; g < fila->cant_golpes; g++) {
+            board->golpes[board->cant_golpes++] = board->golpes[fila->primer_golpe + g];
+        }
+    }
+}
+
+/**
+ * Aplica los golpes anotados por la detección:
+ * 1. Resta el daño y saca de la lista a los zombies que mueren.
+ * 2. Saca del bucket de su fila a las arvejas que impactaron, compactando
+ *    (una sola pasada por fila, solo en las filas con golpes).
+ * 3. Las saca del array. Con swap-remove la última puede caer en el lugar
+ *    de otra que también impactó; por eso se repite mientras el lugar
+ *    tenga una arveja marcada (pos_en_fila == -1).
+ */
+static void aplicarGolpes(GameBoard* board) {
+    int filas_con_golpes = 0;
+    for (int g = 0; g < board->cant_golpes; g++) {
+        Golpe* golpe = &board->golpes[g];
+        ZombieNode* z_node = gameBoardGetZombie(board, golpe->zombie);
+        z_node->zombie_data.vida -= golpe->dano;
+        if (z_node->zombie_data.vida <= 0) {
+            removeZombieNode(board, golpe->fila, z_node);
+        }
+        board->arvejas[golpe->arveja].pos_en_fila = -1;
+        filas_con_golpes |= 1 << golpe->fila;
+    }
+
+    for (int r = 0; r < GRID_ROWS; r++) {
+        if (!(filas_con_golpes & (1 << r))) continue;
+        GardenRow* fila = &board->rows[r];
+        int quedan = 0;
+        for (int k = 0; k < fila->cant_arvejas; k++) {
+            int i = fila->indices_arvejas[k];
+            if (board->arvejas[i].pos_en_fila < 0) continue;
+            fila->indices_arvejas[quedan] = i;
+            board->arvejas[i].pos_en_fila = quedan;
+            quedan++;
+        }
+        fila->cant_arvejas = quedan;
+        if (quedan == 0) {
+            board->filas_con_arvejas &= ~(1 << r);
+        }
+    }
+
+    for (int g = 0; g < board->cant_golpes; g++) {
+        int i = board->golpes[g].arveja;
+        while (i < board->cant_arvejas && board->arvejas[i].pos_en_fila < 0) {
+            devolverSlotArveja(board, i);
+        }
+    }
+}
+
+/**
+ * Devuelve los golpes del último tick (arveja, zombie y daño) y su
+ * cantidad en 'cantidad'. El buffer es del board y se pisa en el próximo
+ * gameBoardUpdate: sirve para estadísticas, efectos o repeticiones.
+ */
+const Golpe* gameBoardGetHits(GameBoard* board, int* cantidad) {
+    if (board == NULL || cantidad == NULL) {
+        printf("Error: Parametro NULL en gameBoardGetHits\n");
+        return NULL;
+    }
+    *cantidad = board->cant_golpes;
+    return board->golpes;
+}
+
+/**
+ * Primer zombie que la arveja tiene en su camino: el de más adelante
+ * cuyo borde derecho todavía está a la derecha de la arveja (el mismo
+ * que elige el sort-and-sweep). NULL si ya los pasó a todos.
+ */
+static ZombieNode* primerZombieAdelante(GardenRow* fila, const SDL_Rect* a) {
+    return buscarZombieAdelante(fila, a->x);
+}
+
+/**
+ * Cantidad de ticks hasta que una arveja que todavía NO toca al zombie
+ * (pero lo tiene adelante) se superpone con él. La arveja avanza
+ * PEA_SPEED_FX y el zombie retrocede ZOMBIE_SPEED_FX por tick, así que
+ * se busca el menor d con:
+ *     FX_TO_INT(zombie_x - d * ZOMBIE_SPEED_FX) < borde_arveja + d * PEA_SPEED
+ * que, pasando todo a punto fijo, es una división entera. Siempre da >= 1.
+ * Como se acercan mucho menos de lo que miden, no se pueden "atravesar"
+ * entre un tick y el siguiente sin que el kernel de colisión lo vea.
+ */
+static int ticksHastaImpacto(int borde_derecho_arveja, int zombie_pos_x) {
+    long long distancia = (long long)zombie_pos_x - INT_TO_FX((long long)borde_derecho_arveja);
+    long long cierre = (long long)ZOMBIE_SPEED_FX + PEA_SPEED_FX;
+    if (distancia < 0) {
+        return 1; // No debería pasar: ya se estarían tocando
+    }
+    return (int)(distancia / cierre + 1);
+}
+
+/**
+ * Fase de colisiones del modo eventos: resuelve las arvejas cuyo tick de
+ * impacto ya llegó, en el mismo orden que el sort-and-sweep (por x).
+ * Cada evento se revisa contra el estado actual de la fila antes de
+ * aplicarlo: si el zombie que iba a tocar murió, la arveja busca el
+ * siguiente y se reprograma; si no le queda ninguno adelante, sale de la
+ * cola hasta que spawnee otro zombie en su fila.
+ */
+static void procesarImpactos(GameBoard* board) {
+    while (board->cant_impactos > 0) {
+        int i = board->impactos[0];
+        Arveja* a = &board->arvejas[i];
+        if (a->tick_impacto > board->tick) {
+            break; // El resto de la cola vence más adelante
+        }
+
+        int r = board->arvejas_fila[i];
+        SDL_Rect rect = rectDeArveja(board, i);
+        ZombieNode* z_node = primerZombieAdelante(&board->rows[r], &rect);
+        if (z_node == NULL || !z_node->zombie_data.activo) {
+            desprogramarImpacto(board, i);
+        } else if (arvejaTocaZombie(&rect, &z_node->zombie_data.rect)) {
+            // Acá el golpe se aplica en el momento: los eventos ya están en orden
+            anotarGolpe(board, i, r, z_node);
+            liberarArveja(board, i);
+            z_node->zombie_data.vida -= PEA_DAMAGE;
+            if (z_node->zombie_data.vida <= 0) {
+                removeZombieNode(board, r, z_node);
+            }
+        } else {
+            int d = ticksHastaImpacto(rect.x + rect.w, z_node->zombie_data.pos_x);
+            programarImpacto(board, i, board->tick + d);
+        }
+    }
+}
+
+/**
+ * Indica si la planta tiene a quién dispararle. Sin zombies en la fila
+ * nunca (O(1) con el contador); si la planta tiene alcance limitado, el
+ * zombie más cercano adelante de donde sale la arveja tiene que estar
+ * dentro del alcance (búsqueda binaria en el índice de la fila).
+ */
+static int plantaTieneBlanco(GameBoard* board, int row, Planta* p) {
+    if (board->rows[row].zombies_activos == 0) {
+        return 0;
+    }
+    if (p->alcance <= 0) {
+        return 1;
+    }
+    int boca = p->rect.x + (CELL_WIDTH / 2); // Desde donde sale la arveja
+    ZombieNode* z_node = buscarZombieAdelante(&board->rows[row], boca);
+    return z_node != NULL && z_node->zombie_data.rect.x - boca <= p->alcance;
+}
+
+/**
+ * Ticks que faltan para que el zombie más cercano que la planta tiene
+ * adelante entre en su alcance: el menor d con
+ *     FX_TO_INT(pos_x - d * ZOMBIE_SPEED_FX) - boca <= alcance
+ * (que se despeja igual que en ticksHastaImpacto). Si no tiene ningún
+ * zombie adelante devuelve -1: los que ya la pasaron se alejan, así que
+ * solo puede aparecerle uno si spawnea.
+ */
+static int ticksHastaEntrarEnRango(GameBoard* board, Planta* p) {
+    int boca = p->rect.x + (CELL_WIDTH / 2);
+    ZombieNode* z_node = buscarZombieAdelante(&board->rows[p->row], boca);
+    if (z_node == NULL) {
+        return -1;
+    }
+    long long distancia = (long long)z_node->zombie_data.pos_x - INT_TO_FX((long long)boca + p->alcance + 1);
+    if (distancia < 0) {
+        return 1; // Ya está en rango (no debería pasar: se habría disparado)
+    }
+    return (int)(distancia / ZOMBIE_SPEED_FX + 1);
+}
+
+/**
+ * Ticks que faltan (contando el actual como 0) para que la animación de
+ * la planta pase al frame de disparo. Todas las plantas recorren el mismo
+ * ciclo de PEASHOOTER_TOTAL_FRAMES * PEASHOOTER_ANIMATION_SPEED ticks,
+ * corrido según su fase, y el frame de disparo empieza siempre en el
+ * mismo punto del ciclo.
+ */
+static int ticksHastaFrameDeDisparo(GameBoard* board, Planta* p) {
+    int ciclo = PEASHOOTER_TOTAL_FRAMES * PEASHOOTER_ANIMATION_SPEED;
+    int faltan = (PEASHOOTER_SHOOT_FRAME * PEASHOOTER_ANIMATION_SPEED - (board->tick - p->fase)) % ciclo;
+    return faltan < 0 ? faltan + ciclo : faltan;
+}
+
+/**
+ * Lo que antes hacía cada planta en cada tick, pero solo en los ticks en
+ * los que algo cambia:
+ * 1. Terminó el cooldown: si tiene blanco se arma el disparo y se
+ *    programa para el próximo frame de disparo. Si no, espera: en la lista
+ *    de su fila hasta que aparezca un zombie, o (con alcance y un zombie
+ *    adelante) en la rueda hasta el tick en que ese zombie entra en rango.
+ *    Si mientras tanto spawnea otro, se vuelve a fijar antes (ver
+ *    despertarPlantasConAlcance).
+ * 2. Llegó al frame de disparo: dispara (si sigue teniendo blanco) y
+ *    vuelve a la rueda para cuando termine el nuevo cooldown.
+ */
+static void actualizarPlanta(GameBoard* board, Planta* p) {
+    p->esperando_rango = 0;
+    if (!p->debe_disparar) {
+        if (!plantaTieneBlanco(board, p->row, p)) {
+            int faltan = p->alcance > 0 ? ticksHastaEntrarEnRango(board, p) : -1;
+            if (faltan < 0) {
+                esperarZombies(board, p);
+            } else {
+                p->esperando_rango = 1;
+                programarPlanta(board, p, board->tick + faltan);
+            }
+            return;
+        }
+        p->debe_disparar = 1;
+        int faltan = ticksHastaFrameDeDisparo(board, p);
+        if (faltan > 0) {
+            programarPlanta(board, p, board->tick + faltan);
+            return;
+        }
+    }
+
+    if (plantaTieneBlanco(board, p->row, p)) {
+        dispararArveja(board, p, p->row);
+    }
+    p->cooldown = PEASHOOTER_COOLDOWN; // Reinicio cooldown
+    p->debe_disparar = 0;
+    programarPlanta(board, p, board->tick + p->cooldown + 1);
+}
+
+/**
+ * Fase de plantas: recorre solo el slot de la rueda de este tick. Las
+ * plantas que están ahí por una vuelta futura se vuelven a enganchar
+ * sin tocarlas; las demás se actualizan (y se reprograman solas).
+ */
+static void procesarRuedaDePlantas(GameBoard* board) {
+    int slot = board->tick & (RUEDA_PLANTAS - 1);
+    Planta* p = board->rueda_plantas[slot];
+    board->rueda_plantas[slot] = NULL;
+    while (p != NULL) {
+        Planta* sig = p->rueda_sig;
+        if (p->tick_rueda == board->tick) {
+            actualizarPlanta(board, p);
+        } else {
+            engancharPlanta(&board->rueda_plantas[slot], p);
+        }
+        p = sig;
+    }
+}
+
+/**
+ * Helper para manejar el spawn de zombies.
+ * Si hay oleadas cargadas, spawnea los eventos de la línea de tiempo que
+ * vencen en este tick: está ordenada, así que solo se mira el próximo
+ * (O(1) por tick más O(1) por evento). Si no, un zombie en una fila al
+ * azar cada ZOMBIE_SPAWN_RATE ticks. En ningún caso hay un contador que
+ * se decremente en cada tick: se compara con el tick del board.
+ */
+static void generarZombieSiNecesario(GameBoard* board) {
+    if (board->oleadas_cargadas) {
+        while (board->proxima_oleada < board->cant_oleadas &&
+               board->oleadas[board->proxima_oleada].tick <= board->tick) {
+            EventoOleada* ev = &board->oleadas[board->proxima_oleada++];
+            if (ev->cantidad == 1) {
+                gameBoardAddZombie(board, ev->row);
+            } else {
+                gameBoardAddZombies(board, ev->row, ev->cantidad, ev->espaciado);
+            }
+        }
+        return;
+    }
+
+    if (board->tick >= board->proximo_spawn) {
+        int random_row = rand() % GRID_ROWS;
+        gameBoardAddZombie(board, random_row); // Llama a la función de inserción
+        board->proximo_spawn = board->tick + ZOMBIE_SPAWN_RATE;
+    }
+}
+
+/**
+ * Mueve un tramo de los zombies de una fila un tick (fase 1 del update).
+ * Los recorre por el índice ordenado de la fila: el tramo [desde, hasta)
+ * son posiciones dentro de los zombies vivos del índice.
+ */
+static void moverTramoDeZombies(GameBoard* board, int fila, int desde, int hasta) {
+    ZombieNode** zombies = &board->rows[fila].zombies_por_x[board->rows[fila].inicio_zombies];
+    for (int k = desde; k < hasta; k++) {
+        Zombie* z = &zombies[k]->zombie_data;
+        if (z->activo) {
+            z->pos_x -= ZOMBIE_SPEED_FX;
+            z->rect.x = FX_TO_INT(z->pos_x);
+        }
+    }
+}
+
+/**
+ * Mueve un tramo del array de arvejas un tick (fase 3 del update con
+ * hilos). La máscara de salidas no hace falta: ver gameBoardUpdate.
+ */
+static void avanzarTramoDeArvejas(GameBoard* board, int fila, int desde, int hasta) {
+    avanzarArvejas(&board->arvejas_x[desde], &board->arvejas_fila[desde], hasta - desde);
+}
+
+/**
+ * Avanza el estado del juego un "tick".
+ * Con hilos (ver gameBoardSetHilos), las fases sin datos compartidos
+ * entre filas se reparten como trabajos.
+ */
+void gameBoardUpdate(GameBoard* board) {
+    if (board == NULL) {
+        return;
+    }
+
+    // ===== 0. COMANDOS DEL INPUT =====
+    // Se aplican antes del tick, como si se hubieran llamado directamente
+    procesarComandos(board);
+
+    board->tick++;
+
+    // ===== 1. ACTUALIZAR ZOMBIES =====
+    // (Los zombies muertos ya se sacaron de la lista en la fase 4)
+    // Solo se mueven: la animación se calcula al dibujar (ver frameZombie)
+    for (int r = 0; r < GRID_ROWS; r++) {
+        if (board->filas_con_zombies & (1 << r)) {
+            paraleloPorTramos(board, moverTramoDeZombies, r, board->rows[r].zombies_activos, TRAMO_ZOMBIES);
+        }
+    }
+    esperarTrabajos(board);
+
+    // ===== 2. ACTUALIZAR PLANTAS =====
+    // Cooldown y disparo: solo las plantas cuyo tick llegó en la rueda.
+    // La animación no se actualiza: sale del tick (ver framePlanta).
+    procesarRuedaDePlantas(board);
+
+    // ===== 3. ACTUALIZAR ARVEJAS =====
+    // Primero se mueven todas de corrido y después se sacan las que
+    // salieron de la pantalla, solo en las filas marcadas. Con hilos se
+    // mueven por tramos del array, y como cada bucket está ordenado, una
+    // fila tiene salidas si y solo si la última salió.
+    int filas_con_salidas;
+    if (board->pool == NULL) {
+        filas_con_salidas = avanzarArvejas(board->arvejas_x, board->arvejas_fila, board->cant_arvejas);
+    } else {
+        paraleloPorTramos(board, avanzarTramoDeArvejas, -1, board->cant_arvejas, TRAMO_ARVEJAS);
+        esperarTrabajos(board);
+        filas_con_salidas = board->filas_con_arvejas;
+    }
+    for (int r = 0; r < GRID_ROWS; r++) {
+        if (filas_con_salidas & (1 << r)) {
+            sacarArvejasFueraDePantalla(board, r);
+        }
+    }
+
+    // ===== 4. DETECTAR COLISIONES ARVEJA-ZOMBIE =====
+    // Primero se detectan todos los golpes y después se aplican
+    board->cant_golpes = 0;
+    if (board->modo_eventos) {
+        procesarImpactos(board); // Solo los impactos que vencen en este tick
+    } else {
+        detectarColisiones(board);
+        aplicarGolpes(board);
+    }
+
+    // ===== 5. GENERAR NUEVOS ZOMBIES =====
+    generarZombieSiNecesario(board);
+}
+
+
+
+
+// ========= GAME BOARD IS GAME OVER ==========
+
+/**
+ * Indica si algún zombie llegó a la casa.
+ * La condición es la misma que el juego base (x supera la línea de la casa),
+ * pero en lugar de recorrer todos los zombies de cada fila alcanza con
+ * mirar el de más adelante (front_zombie), que el board mantiene al día.
+ */
+int gameBoardIsGameOver(GameBoard* board) {
+    if (board == NULL) {
+        return 0;
+    }
+
+    for (int r = 0; r < GRID_ROWS; r++) {
+        if (!(board->filas_con_zombies & (1 << r))) continue;
+        ZombieNode* front = board->rows[r].front_zombie;
+        if (front != NULL) {
+            Zombie* z = &front->zombie_data;
+            if (z->activo && z->rect.x < GRID_OFFSET_X - z->rect.w) {
+                return 1;
+            }
+        }
+    }
+    return 0;
+}
+
+
+
+
+// ========= GAME BOARD ADVANCE ==========
+
+/**
+ * Ticks que faltan (>= 1) para el próximo tick en el que alguna planta
+ * de la rueda tiene algo que hacer. Se recorren los slots desde el del
+ * tick siguiente y se corta en el primero que tiene una planta para ese
+ * tick (las de vueltas futuras se saltean). Si en una vuelta entera no
+ * hay ninguna, alcanza con frenar al completarla: en ese tick no pasa
+ * nada y se vuelve a buscar desde ahí. Las plantas que esperan zombies
+ * no cuentan: solo las despierta un spawn, que ya es un evento.
+ */
+static int ticksHastaPlanta(GameBoard* board, int tope) {
+    if (tope > RUEDA_PLANTAS) {
+        tope = RUEDA_PLANTAS;
+    }
+    for (int d = 1; d < tope; d++) {
+        int tick = board->tick + d;
+        for (Planta* p = board->rueda_plantas[tick & (RUEDA_PLANTAS - 1)]; p != NULL; p = p->rueda_sig) {
+            if (p->tick_rueda == tick) {
+                return d;
+            }
+        }
+    }
+    return tope;
+}
+
+/**
+ * Ticks que faltan (>= 1) para el próximo spawn: el próximo evento de la
+ * línea de tiempo, o el del spawn aleatorio.
+ */
+static int ticksHastaSpawn(GameBoard* board, int tope) {
+    int d = tope;
+    if (board->oleadas_cargadas) {
+        if (board->proxima_oleada < board->cant_oleadas) {
+            d = board->oleadas[board->proxima_oleada].tick - board->tick;
+        }
+    } else {
+        d = board->proximo_spawn - board->tick;
+    }
+    if (d > tope) d = tope;
+    return d < 1 ? 1 : d;
+}
+
+/**
+ * Ticks que faltan (>= 1) para el próximo golpe de una arveja.
+ * En modo eventos es el tope de la cola de impactos. Si no, se recorre
+ * cada fila como el sort-and-sweep: cada arveja solo puede tocar primero
+ * al zombie que tiene adelante, y ticksHastaImpacto da cuándo.
+ */
+static int ticksHastaGolpe(GameBoard* board, int tope) {
+    if (board->modo_eventos) {
+        if (board->cant_impactos > 0) {
+            int d = board->arvejas[board->impactos[0]].tick_impacto - board->tick;
+            if (d < tope) tope = d;
+        }
+        return tope < 1 ? 1 : tope;
+    }
+
+    int filas = board->filas_con_zombies & board->filas_con_arvejas;
+    for (int r = 0; r < GRID_ROWS; r++) {
+        if (!(filas & (1 << r))) continue;
+        GardenRow* fila = &board->rows[r];
+        ZombieNode* z_node = fila->front_zombie;
+        for (int k = 0; k < fila->cant_arvejas && z_node != NULL; k++) {
+            SDL_Rect a = rectDeArveja(board, fila->indices_arvejas[k]);
+            while (z_node != NULL &&
+                   z_node->zombie_data.rect.x + z_node->zombie_data.rect.w <= a.x) {
+                z_node = z_node->prev;
+            }
+            if (z_node != NULL) {
+                int d = ticksHastaImpacto(a.x + a.w, z_node->zombie_data.pos_x);
+                if (d < tope) tope = d;
+            }
+        }
+    }
+    return tope < 1 ? 1 : tope;
+}
+
+/**
+ * Ticks que faltan (>= 1) para que alguna arveja salga de la pantalla.
+ * En cada fila alcanza con mirar la última del bucket (la de mayor x).
+ */
+static int ticksHastaSalida(GameBoard* board, int tope) {
+    for (int r = 0; r < GRID_ROWS; r++) {
+        if (!(board->filas_con_arvejas & (1 << r))) continue;
+        GardenRow* fila = &board->rows[r];
+        int x = xDeArveja(board, fila->indices_arvejas[fila->cant_arvejas - 1]);
+        int d = (SCREEN_WIDTH - x) / PEA_SPEED + 1;
+        if (d < tope) tope = d;
+    }
+    return tope < 1 ? 1 : tope;
+}
+
+/**
+ * Ticks que faltan (>= 1) para que el zombie de más adelante de alguna
+ * fila llegue a la casa: el menor d con
+ *     FX_TO_INT(pos_x - d * ZOMBIE_SPEED_FX) < GRID_OFFSET_X - w
+ */
+static int ticksHastaCasa(GameBoard* board, int tope) {
+    for (int r = 0; r < GRID_ROWS; r++) {
+        if (!(board->filas_con_zombies & (1 << r))) continue;
+        Zombie* z = &board->rows[r].front_zombie->zombie_data;
+        long long distancia = (long long)z->pos_x - INT_TO_FX((long long)(GRID_OFFSET_X - z->rect.w));
+        if (distancia < 0) {
+            return 1; // Ya llegó
+        }
+        long long d = distancia / ZOMBIE_SPEED_FX + 1;
+        if (d < tope) tope = (int)d;
+    }
+    return tope;
+}
+
+/**
+ * Cantidad de ticks (entre 0 y 'tope') a partir del actual en los que no
+ * pasa nada más que zombies y arvejas avanzando: ninguna planta sale de
+ * la rueda, no hay golpes, ninguna arveja sale de la pantalla, no spawnea
+ * nadie y (si 'mirar_casa') ningún zombie llega a la casa.
+ */
+static int ticksTranquilos(GameBoard* board, int tope, int mirar_casa) {
+    int d = tope + 1; // Tick del próximo evento, contando desde el actual
+    d = ticksHastaPlanta(board, d);
+    d = ticksHastaSpawn(board, d);
+    d = ticksHastaSalida(board, d);
+    d = ticksHastaGolpe(board, d);
+    if (mirar_casa) {
+        d = ticksHastaCasa(board, d);
+    }
+    return d - 1;
+}
+
+/**
+ * Avanza 'n' ticks tranquilos de una: es lo mismo que hacer n veces las
+ * fases 1 y 3 de gameBoardUpdate, porque todos se mueven a velocidad
+ * constante en punto fijo. Las animaciones no se tocan: salen del tick.
+ */
+static void saltarTicks(GameBoard* board, int n) {
+    board->tick += n;
+
+    for (int r = 0; r < GRID_ROWS; r++) {
+        if (!(board->filas_con_zombies & (1 << r))) continue;
+        for (ZombieNode* z_node = board->rows[r].first_zombie; z_node != NULL; z_node = z_node->next) {
+            Zombie* z = &z_node->zombie_data;
+            if (z->activo) {
+                z->pos_x = (int)(z->pos_x - (long long)n * ZOMBIE_SPEED_FX);
+                z->rect.x = FX_TO_INT(z->pos_x);
+            }
+        }
+    }
+
+    for (int i = 0; i < board->cant_arvejas; i++) {
+        board->arvejas_x[i] = (int)(board->arvejas_x[i] + (long long)n * PEA_SPEED_FX);
+    }
+
+    board->cant_golpes = 0; // Como en cualquier tick sin golpes
+}
+
+/**
+ * Avanza el juego hasta 'n_ticks' ticks, con el mismo resultado que
+ * llamar a gameBoardUpdate esa cantidad de veces. Los tramos en los que
+ * solo caminan zombies y vuelan arvejas se saltan de una (en forma
+ * cerrada); los ticks con algún evento (disparo, golpe, arveja que sale,
+ * spawn) se hacen con gameBoardUpdate.
+ * Si el juego termina en el medio (un zombie llega a la casa) se frena en
+ * ese tick, igual que el bucle principal. Devuelve los ticks avanzados.
+ * Los comandos encolados antes de llamarla se aplican de entrada (como
+ * en el primer gameBoardUpdate); los que lleguen durante el avance, en
+ * el próximo tick con eventos.
+ */
+int gameBoardAdvance(GameBoard* board, int n_ticks) {
+    if (board == NULL) {
+        printf("Error: Board NULL en gameBoardAdvance\n");
+        return 0;
+    }
+    if (n_ticks < 0) {
+        printf("Error: Cantidad de ticks negativa en gameBoardAdvance (%d)\n", n_ticks);
+        return 0;
+    }
+
+    if (n_ticks > 0) {
+        procesarComandos(board);
+    }
+
+    int ya_termino = gameBoardIsGameOver(board);
+    int avanzados = 0;
+    while (avanzados < n_ticks) {
+        int quietos = ticksTranquilos(board, n_ticks - avanzados, !ya_termino);
+        if (quietos > 0) {
+            saltarTicks(board, quietos);
+            avanzados += quietos;
+            if (avanzados == n_ticks) {
+                break;
+            }
+        }
+
+        // El tick siguiente tiene algún evento
+        gameBoardUpdate(board);
+        avanzados++;
+        if (!ya_termino && gameBoardIsGameOver(board)) {
+            break;
+        }
+    }
+    return avanzados;
+}
+
+
+
+
+// ========= GAME BOARD DRAW ==========
+
+/**
+ * Frame de animación del zombie en el tick actual, a partir de los ticks
+ * que pasaron desde que spawneó. La simulación no hace ningún trabajo de
+ * animación: si nadie dibuja (tests, avance rápido), no se calcula nunca.
+ */
+static int frameZombie(GameBoard* board, Zombie* z) {
+    return ((board->tick - z->tick_spawn) / ZOMBIE_ANIMATION_SPEED) % ZOMBIE_TOTAL_FRAMES;
+}
+
+/**
+ * Dibuja el estado actual del juego en la pantalla.
+ * Esta función implementa la lógica de la consigna,
+ * adaptando la función 'dibujar' del juego base a las nuevas
+ * estructuras de listas enlazadas.
+ *
+ * La idea principal es dibujar en "capas", de atrás hacia adelante:
+ * 1. Fondo -> 2. Plantas -> 3. Arvejas -> 4. Zombies -> 5. UI (Cursor)
+ */
+void gameBoardDraw(GameBoard* board) {
+    // Validaciones básicas
+    if (board == NULL || renderer == NULL) {
+        return;
+    }
+
+    // 1. Limpiar el frame anterior
+    SDL_RenderClear(renderer);
+
+    // 2. Dibujar el fondo
+    if (tex_background != NULL) {
+        SDL_RenderCopy(renderer, tex_background, NULL, NULL);
+    }
+
+    // 3. DIBUJAR PLANTAS
+    // Recorro las 5 filas (salteando las que no tienen plantas)
+    for (int r = 0; r < GRID_ROWS; r++) {
+        if (!(board->filas_con_plantas & (1 << r))) continue;
+        // Recorro la lista de segmentos de cada fila
+        RowSegment* seg = board->rows[r].first_segment;
+        while (seg != NULL) {
+            // Si el segmento es una planta y está activa, la dibujo
+            if (seg->status == STATUS_PLANTA && seg->planta_data != NULL) {
+                Planta* p = seg->planta_data;
+                if (p->activo) {
+                    // Calculo el 'src_rect' para tomar el cuadro de animación correcto
+                    // de la hoja de sprites (sprite sheet).
+                    SDL_Rect src_rect = {
+                        framePlanta(board, p) * PEASHOOTER_FRAME_WIDTH,
+                        0,
+                        PEASHOOTER_FRAME_WIDTH,
+                        PEASHOOTER_FRAME_HEIGHT
+                    };
+                    SDL_RenderCopy(renderer, tex_peashooter_sheet, &src_rect, &p->rect);
+                }
+            }
+            seg = seg->next;
+        }
+    }
+
+    // 4. DIBUJAR ARVEJAS
+    // (Las arvejas siguen en un array, ahora dinámico y compacto)
+    if (tex_pea != NULL) {
+        for (int i = 0; i < board->cant_arvejas; i++) {
+            // El 'src_rect' es NULL porque 'pea.png' no es una hoja de sprites
+            SDL_Rect rect = rectDeArveja(board, i);
+            SDL_RenderCopy(renderer, tex_pea, NULL, &rect);
+        }
+    }
+
+    // 5. DIBUJAR ZOMBIES
+    // Recorro las 5 filas (salteando las que no tienen zombies)
+    for (int r = 0; r < GRID_ROWS; r++) {
+        if (!(board->filas_con_zombies & (1 << r))) continue;
+        // Recorro la lista de zombies de cada fila
+        ZombieNode* z_node = board->rows[r].first_zombie;
+        while (z_node != NULL) {
+            Zombie* z = &z_node->zombie_data;
+            if (z->activo) {
+                // Calculo el 'src_rect' para la animación del zombie
+                SDL_Rect src_rect = {
+                    frameZombie(board, z) * ZOMBIE_FRAME_WIDTH,
+                    0,
+                    ZOMBIE_FRAME_WIDTH,
+                    ZOMBIE_FRAME_HEIGHT
+                };
+                SDL_RenderCopy(renderer, tex_zombie_sheet, &src_rect, &z->rect);
+            }
+            z_node = z_node->next;
+        }
+    }
+
+    // 6. DIBUJAR CURSOR (UI)
+    // Es importante guardar y restaurar el color de dibujo
+    // para no afectar otros elementos de la UI.
+    Uint8 r, g, b, a;
+    SDL_GetRenderDrawColor(renderer, &r, &g, &b, &a); // Guardo color
+    
+    SDL_SetRenderDrawColor(renderer, 255, 255, 0, 200); // Amarillo
+    SDL_Rect cursor_rect = {
+        GRID_OFFSET_X + (cursor.col * CELL_WIDTH),
+        GRID_OFFSET_Y + (cursor.row * CELL_HEIGHT),
+        CELL_WIDTH,
+        CELL_HEIGHT
+    };
+    SDL_RenderDrawRect(renderer, &cursor_rect);
+    
+    SDL_SetRenderDrawColor(renderer, r, g, b, a); // Restauro color
+
+    // 7. Muestro el frame terminado en la pantalla
+    SDL_RenderPresent(renderer);
+}
+
+
+
+//=========== STR DUPLICATE ===========
+/**
+ * Duplica un string en una nueva área de memoria.
+ * La idea es calcular la longitud de src, pedir memoria con malloc
+ * (longitud + 1 para el '\0') y copiar todo el contenido.
+ * Esto resuelve el problema de necesitar copias independientes.
+ */
+char* strDuplicate(char* src) {
+    // Valido la entrada
+    if (src == NULL) {
+        return NULL;  
+    }
+
+    //Calculo la longitud de src
+    size_t len = 0;
+    while (src[len] != '\0') {
+        len++;
+    }
+
+    // Asigno memoria para el nuevo string (longitud + 1)
+    char* nuevo = malloc(len + 1);  
+    if (nuevo == NULL) {    // Fallo en malloc
+        return NULL;
+    }
+
+    // Copio el contenido de src a nuevo, incluyendo el '\0'
+    for (size_t i = 0; i <= len; i++) {  
+        nuevo[i] = src[i];
+    }
+    return nuevo;
+}
+
+
+//=========== STR COMPARE ===========
+/**
+ * Compara dos strings lexicográficamente (orden ASCII).
+ * Resuelve la necesidad de ordenar o comparar strings siguiendo
+ * las reglas de la consigna:
+ * 0 si son iguales,
+ * 1 si s1 < s2,
+ * -1 si s1 > s2.
+ */
+int strCompare(char* s1, char* s2) {
+    // Manejo robusto de casos NULL
+    if (s1 == NULL && s2 == NULL) return 0; // Iguales
+    if (s1 == NULL) return 1;  // NULL se considera "menor"
+    if (s2 == NULL) return -1; // "mayor" que NULL
+    
+    // Itero hasta encontrar la primera diferencia o el fin de un string
+    size_t i = 0;
+    while (s1[i] != '\0' && s2[i] != '\0' && s1[i] == s2[i]) {
+        i++;
+    }
+    
+    // Analizo el carácter donde frenó
+    if (s1[i] == s2[i]) {
+        return 0;  // Son iguales (ambos llegaron a '\0')
+    } else if ((unsigned char)s1[i] < (unsigned char)s2[i]) {
+        return 1;  // s1 es menor
+    } else {
+        return -1; // s1 es mayor
+    }
+}
+
+
+//=========== STR CONCATENATE ================
+/**
+ * Concatena dos strings (src1 y src2) en uno nuevo.
+ * La idea es calcular las longitudes, pedir memoria para la suma
+ * de ambas (más el '\0') y copiar ambos contenidos.
+ * Resuelve el requisito de la consigna de liberar la memoria
+ * de los strings originales.
+ */
+char* strConcatenate(char* src1, char* src2) {
+    // Calcular longitudes de src1 y src2, manejando NULLs
+    size_t len1 = 0;
+    if (src1 != NULL) {
+        while (src1[len1] != '\0') len1++;
+    }
+    size_t len2 = 0;
+    if (src2 != NULL) {
+        while (src2[len2] != '\0') len2++;
+    }
+
+    // Asignar memoria para el string resultante
+    char* resultado = malloc(len1 + len2 + 1);
+    
+    // Si falla malloc, libero la memoria original (como pide la consigna)
+    if (resultado == NULL) {
+        free(src1);  
+        free(src2);
+        return NULL;
+    }
+
+    // Copio src1 en resultado
+    size_t i = 0;
+    if (src1 != NULL) {
+        for (; i < len1; i++) {
+            resultado[i] = src1[i];
+        }
+    }
+
+    // Copio src2 a continuación
+    size_t j = 0;
+    if (src2 != NULL) {
+        for (; j < len2; j++, i++) {
+            resultado[i] = src2[j];
+        }
+    }
+    // Termino el nuevo string
+    resultado[i] = '\0';
+
+    // Libero la memoria de los strings originales (consigna)
+    free(src1);
+    free(src2);
+    return resultado;
+}
+
+
+
+
+// ========= GAME BOARD LOAD WAVES ==========
+
+/**
+ * Indica si del texto solo queda espacio en blanco (o el fin de línea).
+ */
+static int soloEspacios(const char* c) {
+    while (*c == ' ' || *c == '\t' || *c == '\r' || *c == '\n') c++;
+    return *c == '\0';
+}
+
+/**
+ * Consume lo que queda de una línea que no entró en el buffer de fgets,
+ * hasta el fin de línea o de archivo. Indica si era solo espacio en blanco.
+ */
+static int descartarRestoDeLinea(FILE* archivo) {
+    int en_blanco = 1;
+    int ch;
+    while ((ch = fgetc(archivo)) != EOF && ch != '\n') {
+        if (ch != ' ' && ch != '\t' && ch != '\r') {
+            en_blanco = 0;
+        }
+    }
+    return en_blanco;
+}
+
+/**
+ * Lee una línea de tiempo de oleadas de un archivo ya abierto.
+ * Formato (texto plano, una oleada por línea):
+ *
+ *     # tick  fila  cantidad  tipo    [espaciado]
+ *     300     2     1         normal
+ *     1200    0     10        normal  30
+ *
+ * Las líneas vacías y las que empiezan con '#' se ignoran (de cualquier
+ * largo). El tick se cuenta desde que se carga el archivo; el espaciado
+ * (en píxeles) es opcional y por defecto es OLEADA_ESPACIADO.
+ * Al cargar se "compila" todo a un array ordenado por tick (inserción,
+ * que es estable: dos oleadas en el mismo tick salen en el orden del
+ * archivo y, como el archivo suele venir ordenado, casi no mueve nada).
+ * Si alguna línea es inválida (campos de más o mal escritos, valores
+ * fuera de rango, un tick que desborda al sumarle el del board, o una
+ * oleada tan larga que gameBoardAddZombies la rechazaría) no se cambia
+ * nada y devuelve 0.
+ */
+static int cargarOleadas(GameBoard* board, FILE* archivo) {
+    EventoOleada* eventos = NULL;
+    int cant = 0;
+    int capacidad = 0;
+    char linea[256];
+    int nro_linea = 0;
+
+    while (fgets(linea, sizeof(linea), archivo) != NULL) {
+        nro_linea++;
+        // Si la línea no entró entera, el resto no se lee como otra línea:
+        // se descarta (en una oleada solo puede ser espacio en blanco)
+        size_t largo = 0;
+        while (linea[largo] != '\0') largo++;
+        int resto_en_blanco = 1;
+        if (largo > 0 && linea[largo - 1] != '\n' && !feof(archivo)) {
+            resto_en_blanco = descartarRestoDeLinea(archivo);
+        }
+        char* c = linea;
+        while (*c == ' ' || *c == '\t') c++;
+        if (*c == '#' || *c == '\n' || *c == '\r' || *c == '\0') {
+            continue; // Comentario o línea vacía
+        }
+        if (!resto_en_blanco) {
+            printf("Error: Linea %d demasiado larga en el archivo de oleadas\n", nro_linea);
+            free(eventos);
+            return 0;
+        }
+
+        // Los campos obligatorios, y después o nada o el espaciado: con %n
+        // se sabe dónde terminó cada parte, así no se aceptan campos de más
+        // ni un espaciado mal escrito
+        EventoOleada ev;
+        char tipo[32];
+        int leidos = 0;
+        int valida = sscanf(c, "%d %d %d %31s%n", &ev.tick, &ev.row, &ev.cantidad, tipo, &leidos) == 4;
+        ev.espaciado = OLEADA_ESPACIADO;
+        if (valida && !soloEspacios(c + leidos)) {
+            char* resto = c + leidos;
+            leidos = 0;
+            valida = sscanf(resto, "%d%n", &ev.espaciado, &leidos) == 1 && soloEspacios(resto + leidos);
+        }
+        if (!valida || ev.tick < 0 || ev.tick > INT_MAX - board->tick || ev.row < 0 || ev.row >= GRID_ROWS ||
+            ev.cantidad <= 0 || ev.espaciado < 0 || !oleadaEntraEnRango(ev.cantidad, ev.espaciado)) {
+            printf("Error: Linea %d invalida en el archivo de oleadas\n", nro_linea);
+            free(eventos);
+            return 0;
+        }
+        if (strCompare(tipo, "normal") == 0) {
+            ev.tipo = ZOMBIE_TIPO_NORMAL;
+        } else {
+            printf("Error: Tipo de zombie '%s' desconocido en la linea %d\n", tipo, nro_linea);
+            free(eventos);
+            return 0;
+        }
+        ev.tick += board->tick;
+
+        if (cant == capacidad) {
+            int nueva_capacidad = capacidad > 0 ? capacidad * 2 : 16;
+            EventoOleada* nuevos = realloc(eventos, nueva_capacidad * sizeof(EventoOleada));
+            if (nuevos == NULL) {
+                printf("Error: No se pudo asignar memoria para las oleadas\n");
+                free(eventos);
+                return 0;
+            }
+            eventos = nuevos;
+            capacidad = nueva_capacidad;
+        }
+
+        // Inserción ordenada por tick (estable)
+        int pos = cant++;
+        while (pos > 0 && eventos[pos - 1].tick > ev.tick) {
+            eventos[pos] = eventos[pos - 1];
+            pos--;
+        }
+        eventos[pos] = ev;
+    }
+
+    // Reemplazo la línea de tiempo anterior (si había)
+    free(board->oleadas);
+    board->oleadas = eventos;
+    board->cant_oleadas = cant;
+    board->proxima_oleada = 0;
+    board->oleadas_cargadas = 1; // Aunque esté vacío: un escenario sin zombies también vale
+    return 1;
+}
+
+/**
+ * Carga un archivo de oleadas (ver cargarOleadas para el formato) y lo usa
+ * en lugar del spawn aleatorio. Sirve para armar escenarios reproducibles,
+ * por ejemplo de carga pesada para medir rendimiento.
+ * Devuelve 1 si lo pudo cargar, 0 si no (y el board queda como estaba).
+ */
+int gameBoardLoadWaves(GameBoard* board, const char* path) {
+    if (board == NULL || path == NULL) {
+        printf("Error: Parametro NULL en gameBoardLoadWaves\n");
+        return 0;
+    }
+    FILE* archivo = fopen(path, "r");
+    if (archivo == NULL) {
+        printf("Error: No se pudo abrir el archivo de oleadas '%s'\n", path);
+        return 0;
+    }
+    int ok = cargarOleadas(board, archivo);
+    fclose(archivo);
+    return ok;
+}
+
+
+
+
+// ========== TESTS STR DUPLICATE ==========
+
+
+/**
+ * Pruebas para strDuplicate.
+ * El objetivo es validar que la copia funcione en casos borde
+ * (vacío, NULL) y que la copia sea independiente en memoria.
+ */
+void testStrDuplicate() {
+    printf("\n========= TESTS strDuplicate =========\n");
+    
+    // TEST 1: Pruebo el caso base: un string vacío
+    char* test1_src = "";
+    char* test1_dup = strDuplicate(test1_src);
+    if (test1_dup != NULL && test1_dup[0] == '\0') {
+        printf("✓ TEST 1 PASADO: String vacio duplicado correctamente\n");
+    } else {
+        printf("✗ TEST 1 FALLADO: String vacio no duplicado correctamente\n");
+    }
+    free(test1_dup);
+    
+    // TEST 2: Pruebo el caso mínimo con contenido
+    char* test2_src = "A";
+    char* test2_dup = strDuplicate(test2_src);
+    if (test2_dup != NULL && test2_dup[0] == 'A' && test2_dup[1] == '\0') {
+        printf("✓ TEST 2 PASADO: String de un caracter duplicado correctamente\n");
+    } else {
+        printf("✗ TEST 2 FALLADO: String de un caracter no duplicado correctamente\n");
+    }
+    free(test2_dup);
+    
+    // TEST 3: Pruebo un string normal
+    char* test3_src = "Hola Mundo 123!";
+    char* test3_dup = strDuplicate(test3_src);
+    int test3_ok = 1;
+    if (test3_dup == NULL) {
+        test3_ok = 0;
+    } else {
+        // Verifico contenido y terminador
+        int i = 0;
+        while (test3_src[i] != '\0') {
+            if (test3_dup[i] != test3_src[i]) {
+                test3_ok = 0;
+                break;
+            }
+            i++;
+        }
+        if (test3_dup[i] != '\0') {
+            test3_ok = 0;
+        }
+    }
+    if (test3_ok) {
+        printf("✓ TEST 3 PASADO: String con varios caracteres duplicado correctamente\n");
+    } else {
+        printf("✗ TEST 3 FALLADO: String con varios caracteres no duplicado correctamente\n");
+    }
+    free(test3_dup);
+    
+    // TEST 4: Pruebo todos los caracteres pedidos por la consigna
+    char* test4_src = "!@#$%^&*()_+-=[]{}|;:',.<>?/0123456789";
+    char* test4_dup = strDuplicate(test4_src);
+    int test4_ok = 1;
+    if (test4_dup == NULL) {
+        test4_ok = 0;
+    } else {
+        int i = 0;
+        while (test4_src[i] != '\0') {
+            if (test4_dup[i] != test4_src[i]) {
+                test4_ok = 0;
+                break;
+            }
+            i++;
+        }
+        if (test4_dup[i] != '\0') {
+            test4_ok = 0;
+        }
+    }
+    if (test4_ok) {
+        printf("✓ TEST 4 PASADO: String con caracteres especiales duplicado correctamente\n");
+    } else {
+        printf("✗ TEST 4 FALLADO: String con caracteres especiales no duplicado correctamente\n");
+    }
+    free(test4_dup);
+    
+    // TEST 5: Pruebo la independencia de la memoria.
+    // Modifico la copia y verifico que el original no cambie.
+    char* test5_src = "Test";
+    char* test5_dup = strDuplicate(test5_src);
+    if (test5_dup != NULL && test5_dup != test5_src) {
+        test5_dup[0] = 'X'; // Modifico la copia
+        if (test5_src[0] == 'T' && test5_dup[0] == 'X') {
+            printf("✓ TEST 5 PASADO: El duplicado es independiente del original\n");
+        } else {
+            printf("✗ TEST 5 FALLADO: El duplicado no es independiente\n");
+        }
+    } else {
+        printf("✗ TEST 5 FALLADO: El duplicado apunta al mismo lugar que el original\n");
+    }
+    free(test5_dup);
+    
+    printf("======================================\n\n");
+
+    // TEST 6: Pruebo la robustez de la función ante un NULL
+    char* test6_dup = strDuplicate(NULL);
+    if (test6_dup == NULL) {
+        printf("✓ TEST 6 PASADO: NULL input retorna NULL\n");
+    } else {
+        printf("✗ TEST 6 FALLADO: NULL input no manejado correctamente\n");
+        free(test6_dup);
+    }
+}
+
+
+
+// ========== TESTS STR COMPARE ==========
+
+
+/**
+ * Pruebas para strCompare.
+ * El objetivo es validar la lógica de comparación lexicográfica
+ * y los valores de retorno pedidos por la consigna (0, 1, -1).
+ */
+void testStrCompare() {
+    printf("\n========= TESTS strCompare =========\n");
+    
+    // TEST 1: Pruebo el caso base: dos strings vacíos
+    char* test1_s1 = "";
+    char* test1_s2 = "";
+    int result1 = strCompare(test1_s1, test1_s2);
+    if (result1 == 0) {
+        printf("✓ TEST 1 PASADO: Dos strings vacios son iguales\n");
+    } else {
+        printf("✗ TEST 1 FALLADO: Dos strings vacios deberian ser iguales (resultado: %d)\n", result1);
+    }
+    
+    // TEST 2: Pruebo igualdad con un carácter
+    char* test2_s1 = "A";
+    char* test2_s2 = "A";
+    int result2 = strCompare(test2_s1, test2_s2);
+    if (result2 == 0) {
+        printf("✓ TEST 2 PASADO: Dos strings de un caracter iguales\n");
+    } else {
+        printf("✗ TEST 2 FALLADO: Dos strings de un caracter iguales (resultado: %d)\n", result2);
+    }
+    
+    // TEST 3: Pruebo (s1 < s2)
+    char* test3_s1 = "abc";
+    char* test3_s2 = "abd";
+    int result3 = strCompare(test3_s1, test3_s2);
+    if (result3 == 1) { // Consigna pide 1
+        printf("✓ TEST 3 PASADO: 'abc' es menor que 'abd'\n");
+    } else {
+        printf("✗ TEST 3 FALLADO: 'abc' deberia ser menor que 'abd' (resultado: %d)\n", result3);
+    }
+    
+    // TEST 4: Pruebo (s1 > s2)
+    char* test4_s1 = "abd";
+    char* test4_s2 = "abc";
+    int result4 = strCompare(test4_s1, test4_s2);
+    if (result4 == -1) { // Consigna pide -1
+        printf("✓ TEST 4 PASADO: 'abd' es mayor que 'abc'\n");
+    } else {
+        printf("✗ TEST 4 FALLADO: 'abd' deberia ser mayor que 'abc' (resultado: %d)\n", result4);
+    }
+    
+    // TEST 5: Pruebo strings diferentes (s1 < s2)
+    char* test5_s1 = "apple";
+    char* test5_s2 = "banana";
+    int result5 = strCompare(test5_s1, test5_s2);
+    if (result5 == 1) { 
+        printf("✓ TEST 5 PASADO: 'apple' es menor que 'banana'\n");
+    } else {
+        printf("✗ TEST 5 FALLADO: 'apple' deberia ser menor que 'banana' (resultado: %d)\n", result5);
+    }
+    
+    // TEST 6: Pruebo strings diferentes (s1 > s2)
+    char* test6_s1 = "banana";
+    char* test6_s2 = "apple";
+    int result6 = strCompare(test6_s1, test6_s2);
+    if (result6 == -1) { 
+        printf("✓ TEST 6 PASADO: 'banana' es mayor que 'apple'\n");
+    } else {
+        printf("✗ TEST 6 FALLADO: 'banana' deberia ser mayor que 'apple' (resultado: %d)\n", result6);
+    }
+    
+    // TEST 7: Pruebo el caso de prefijo (s1 < s2)
+    char* test7_s1 = "test";
+    char* test7_s2 = "testing";
+    int result7 = strCompare(test7_s1, test7_s2);
+    if (result7 == 1) { 
+        printf("✓ TEST 7 PASADO: 'test' es menor que 'testing'\n");
+    } else {
+        printf("✗ TEST 7 FALLADO: 'test' deberia ser menor que 'testing' (resultado: %d)\n", result7);
+    }
+    
+    printf("====================================\n\n");
+
+    // TEST 8: Pruebo el caso de prefijo (s1 > s2)
+    char* test8_s1 = "testing";
+    char* test8_s2 = "test";
+    int result8 = strCompare(test8_s1, test8_s2);
+    if (result8 == -1) { 
+        printf("✓ TEST 8 PASADO: 'testing' es mayor que 'test'\n");
+    } else {
+        printf("✗ TEST 8 FALLADO: 'testing' deberia ser mayor que 'test' (resultado: %d)\n", result8);
+    }
+
+    // TEST 9: Pruebo la sensibilidad a mayúsculas
+    char* test9_s1 = "A";
+    char* test9_s2 = "a";
+    int result9 = strCompare(test9_s1, test9_s2);
+    if (result9 == 1) { 
+        printf("✓ TEST 9 PASADO: 'A' < 'a'\n");
+    } else {
+        printf("✗ TEST 9 FALLADO: 'A' deberia ser menor que 'a' (resultado: %d)\n", result9);
+    }
+
+    // TEST 10: Pruebo la robustez de la función ante NULLs
+    int result10a = strCompare(NULL, NULL);  // 0
+    int result10b = strCompare(NULL, "a");   // 1
+    int result10c = strCompare("a", NULL);   // -1
+    if (result10a == 0 && result10b == 1 && result10c == -1) {
+        printf("✓ TEST 10 PASADO: Manejo de NULL\n");
+    } else {
+        printf("✗ TEST 10 FALLADO: Manejo de NULL incorrecto\n");
+    }
+}
+
+
+
+
+// ========== TESTS STR CONCATENATE ==========
+
+
+/**
+ * Pruebas para strConcatenate.
+ * El objetivo es validar la correcta unión de strings en casos
+ * borde (vacíos, NULL) y la correcta gestión de la memoria,
+ * verificando que los 'src' se liberen.
+ */
+void testStrConcatenate() {
+    printf("\n========= TESTS strConcatenate =========\n");
+    
+    // TEST 1: Pruebo string vacío + string
+    char* test1_s1 = strDuplicate("");
+    char* test1_s2 = strDuplicate("abc");
+    char* result1 = strConcatenate(test1_s1, test1_s2);
+    if (result1 != NULL && result1[0] == 'a' && result1[1] == 'b' && result1[2] == 'c' && result1[3] == '\0') {
+        printf("✓ TEST 1 PASADO: String vacio + 'abc' = 'abc'\n");
+    } else {
+        printf("✗ TEST 1 FALLADO: String vacio + 'abc' deberia ser 'abc'\n");
+    }
+    free(result1);
+    
+    // TEST 2: Pruebo string + string vacío
+    char* test2_s1 = strDuplicate("xyz");
+    char* test2_s2 = strDuplicate("");
+    char* result2 = strConcatenate(test2_s1, test2_s2);
+    if (result2 != NULL && result2[0] == 'x' && result2[1] == 'y' && result2[2] == 'z' && result2[3] == '\0') {
+        printf("✓ TEST 2 PASADO: 'xyz' + string vacio = 'xyz'\n");
+    } else {
+        printf("✗ TEST 2 FALLADO: 'xyz' + string vacio deberia ser 'xyz'\n");
+    }
+    free(result2);
+    
+    // TEST 3: Pruebo string de 1 char + 1 char
+    char* test3_s1 = strDuplicate("A");
+    char* test3_s2 = strDuplicate("B");
+    char* result3 = strConcatenate(test3_s1, test3_s2);
+    if (result3 != NULL && result3[0] == 'A' && result3[1] == 'B' && result3[2] == '\0') {
+        printf("✓ TEST 3 PASADO: 'A' + 'B' = 'AB'\n");
+    } else {
+        printf("✗ TEST 3 FALLADO: 'A' + 'B' deberia ser 'AB'\n");
+    }
+    free(result3);
+    
+    // TEST 4: Pruebo dos strings normales
+    char* test4_s1 = strDuplicate("Hola ");
+    char* test4_s2 = strDuplicate("Mundo");
+    char* result4 = strConcatenate(test4_s1, test4_s2);
+    int test4_ok = 1;
+    char* expected4 = "Hola Mundo";
+    if (result4 == NULL) {
+        test4_ok = 0;
+    } else {
+        // Verifico contenido
+        int i = 0;
+        while (expected4[i] != '\0') {
+            if (result4[i] != expected4[i]) {
+                test4_ok = 0;
+                break;
+            }
+            i++;
+        }
+        if (result4[i] != '\0') {
+            test4_ok = 0;
+        }
+    }
+    if (test4_ok) {
+        printf("✓ TEST 4 PASADO: 'Hola ' + 'Mundo' = 'Hola Mundo'\n");
+    } else {
+        printf("✗ TEST 4 FALLADO: 'Hola ' + 'Mundo' deberia ser 'Hola Mundo'\n");
+    }
+    free(result4);
+    
+    // TEST 5: Prueba conceptual de la gestión de memoria.
+    // Al usar strDuplicate, me aseguro que los 'src' están en el heap.
+    // Si strConcatenate los libera (como pide la consigna) y puedo
+    // liberar el 'resultado' sin crasheos, la memoria se manejó bien.
+    char* test5_s1 = strDuplicate("Test");
+    char* test5_s2 = strDuplicate("123");
+    char* result5 = strConcatenate(test5_s1, test5_s2);
+    if (result5 != NULL) {
+        printf("✓ TEST 5 PASADO: Concatenacion exitosa (memoria liberada internamente)\n");
+    } else {
+        printf("✗ TEST 5 FALLADO: Error en concatenacion\n");
+    }
+    free(result5);
+    
+    printf("========================================\n\n");
+
+    // TEST 6: Pruebo la robustez ante un NULL
+    char* test6_s1 = strDuplicate("Hola");
+    char* test6_s2 = NULL;
+    char* result6 = strConcatenate(test6_s1, test6_s2);
+    if (result6 != NULL && result6[0] == 'H' && result6[4] == '\0') {
+        printf("✓ TEST 6 PASADO: 'Hola' + NULL = 'Hola'\n");
+    } else {
+        printf("✗ TEST 6 FALLADO: 'Hola' + NULL deberia ser 'Hola'\n");
+    }
+    free(result6);
+}
+
+
+
+// ========== TESTS gameBoardAddPlant ==========
+
+
+/**
+ * Pruebas para gameBoardAddPlant.
+ * La idea es validar exhaustivamente la lógica de "división de segmentos",
+ * que es el núcleo de la gestión de la grilla.
+ */
+void testGameBoardAddPlant() {
+    printf("\n========= TESTS gameBoardAddPlant =========\n");
+    
+    GameBoard* board = gameBoardNew();
+    if (board == NULL) {
+        printf("✗ Error al crear tablero para tests\n");
+        return;
+    }
+    
+    // TEST 0: Pruebo la robustez ante inputs inválidos.
+    // La función no debería crashear ni agregar nada.
+    if (gameBoardAddPlant(NULL, 0, 0) == 0 &&
+        gameBoardAddPlant(board, -1, 0) == 0 &&
+        gameBoardAddPlant(board, GRID_ROWS, 0) == 0 &&
+        gameBoardAddPlant(board, 0, -1) == 0 &&
+        gameBoardAddPlant(board, 0, GRID_COLS) == 0) {
+        printf("✓ TEST 0 PASADO: Maneja inputs invalidos correctamente\n");
+    } else {
+        printf("✗ TEST 0 FALLADO: No maneja inputs invalidos\n");
+    }
+    
+    // TEST 1: Pruebo agregar en el medio (Consigna 1)
+    // Valida la lógica de división en 3 segmentos: VACIO-PLANTA-VACIO.
+    if (gameBoardAddPlant(board, 0, 4) == 1) {
+        RowSegment* seg = board->rows[0].first_segment;
+        // Reviso la estructura de la lista: [VACIO, 0, 4] -> [PLANTA, 4, 1] -> [VACIO, 5, 4]
+        if (seg != NULL && seg->status == STATUS_VACIO && seg->start_col == 0 && seg->length == 4 &&
+            seg->next != NULL && seg->next->status == STATUS_PLANTA && seg->next->start_col == 4 && seg->next->length == 1 &&
+            seg->next->next != NULL && seg->next->next->status == STATUS_VACIO && seg->next->next->start_col == 5 && seg->next->next->length == 4 &&
+            seg->next->next->next == NULL) {
+            printf("✓ TEST 1 PASADO: Agregar en medio de fila vacia\n");
+        } else {
+            printf("✗ TEST 1 FALLADO: Estructura incorrecta despues de agregar en medio\n");
+        }
+    } else {
+        printf("✗ TEST 1 FALLADO: No se pudo agregar en medio\n");
+    }
+    
+    // TEST 2: Pruebo agregar al inicio (Consigna 1)
+    // Valida la lógica de división en 2 segmentos al inicio: PLANTA-VACIO.
+    resetRow(board, 0);
+    if (gameBoardAddPlant(board, 0, 0) == 1) {
+        RowSegment* seg = board->rows[0].first_segment;
+        // Reviso la estructura: [PLANTA, 0, 1] -> [VACIO, 1, 8]
+        if (seg != NULL && seg->status == STATUS_PLANTA && seg->start_col == 0 && seg->length == 1 &&
+            seg->next != NULL && seg->next->status == STATUS_VACIO && seg->next->start_col == 1 && seg->next->length == 8 &&
+            seg->next->next == NULL) {
+            printf("✓ TEST 2 PASADO: Agregar al inicio de fila vacia\n");
+        } else {
+            printf("✗ TEST 2 FALLADO: Estructura incorrecta despues de agregar al inicio\n");
+        }
+    } else {
+        printf("✗ TEST 2 FALLADO: No se pudo agregar al inicio\n");
+    }
+    
+    // TEST 3: Pruebo agregar al final (Consigna 1)
+    // Valida la lógica de división en 2 segmentos al final: VACIO-PLANTA.
+    resetRow(board, 0);
+    if (gameBoardAddPlant(board, 0, 8) == 1) {
+        RowSegment* seg = board->rows[0].first_segment;
+        // Reviso la estructura: [VACIO, 0, 8] -> [PLANTA, 8, 1]
+        if (seg != NULL && seg->status == STATUS_VACIO && seg->start_col == 0 && seg->length == 8 &&
+            seg->next != NULL && seg->next->status == STATUS_PLANTA && seg->next->start_col == 8 && seg->next->length == 1 &&
+            seg->next->next == NULL) {
+            printf("✓ TEST 3 PASADO: Agregar al final de fila vacia\n");
+        } else {
+            printf("✗ TEST 3 FALLADO: Estructura incorrecta despues de agregar al final\n");
+        }
+    } else {
+        printf("✗ TEST 3 FALLADO: No se pudo agregar al final\n");
+    }
+    
+    // TEST 4: Pruebo celda ocupada (Consigna 3)
+    // La función debe retornar 0 (fallo) si se planta sobre una PLANTA existente.
+    resetRow(board, 0);
+    gameBoardAddPlant(board, 0, 4); // Planto la primera vez
+    if (gameBoardAddPlant(board, 0, 4) == 0) { // Intento plantar de nuevo
+        printf("✓ TEST 4 PASADO: No permite agregar en celda ocupada\n");
+    } else {
+        printf("✗ TEST 4 FALLADO: Permitio agregar en celda ocupada\n");
+    }
+    
+    // TEST 5: Pruebo llenar la fila (Consigna 2)
+    // Valida que la lista de segmentos maneje el caso de 9 nodos PLANTA seguidos.
+    resetRow(board, 1);
+    int added_all = 1;
+    for (int c = 0; c < GRID_COLS; c++) {
+        if (gameBoardAddPlant(board, 1, c) != 1) {
+            added_all = 0;
+            break;
+        }
+    }
+    if (added_all) {
+        RowSegment* seg = board->rows[1].first_segment;
+        int count = 0;
+        int all_plants = 1;
+        while (seg != NULL) {
+            if (seg->status != STATUS_PLANTA || seg->length != 1) {
+                all_plants = 0;
+                break;
+            }
+            count++;
+            seg = seg->next;
+        }
+        if (all_plants && count == GRID_COLS) {
+            printf("✓ TEST 5 PASADO: Llenar fila completa (9 plantas)\n");
+        } else {
+            printf("✗ TEST 5 FALLADO: Estructura incorrecta (encontradas %d plantas)\n", count);
+        }
+    } else {
+        printf("✗ TEST 5 FALLADO: No se pudo llenar la fila completa\n");
+    }
+    
+    // TEST 6: Prueba avanzada de llenado de huecos.
+    // Simula un patrón de plantado no lineal (pares, luego impares).
+    resetRow(board, 2);
+    int pattern_ok = 1;
+    for (int c = 0; c < GRID_COLS; c += 2) { // Columnas pares
+        if (gameBoardAddPlant(board, 2, c) != 1) pattern_ok = 0;
+    }
+    for (int c = 1; c < GRID_COLS; c += 2) { // Columnas impares (huecos)
+        if (gameBoardAddPlant(board, 2, c) != 1) pattern_ok = 0;
+    }
+    
+    if (pattern_ok) {
+        // Al final, la fila debe estar llena (9 segmentos PLANTA)
+        RowSegment* seg = board->rows[2].first_segment;
+        int plant_count = 0;
+        while (seg != NULL) {
+            if (seg->status == STATUS_PLANTA) plant_count++;
+            seg = seg->next;
+        }
+        if (plant_count == GRID_COLS) {
+            printf("✓ TEST 6 PASADO: Patron alternado y llenado de huecos\n");
+        } else {
+            printf("✗ TEST 6 FALLADO: Esperaba %d plantas, encontre %d\n", GRID_COLS, plant_count);
+        }
+    } else {
+        printf("✗ TEST 6 FALLADO: No se pudo crear patron alternado\n");
+    }
+    
+    // TEST 7: Prueba avanzada de caso borde: plantar en un hueco (length=1) al inicio.
+    resetRow(board, 3);
+    gameBoardAddPlant(board, 3, 1); // Deja hueco en col 0
+    if (gameBoardAddPlant(board, 3, 0) == 1) { // Llena el hueco
+        RowSegment* seg = board->rows[3].first_segment;
+        // Valida que los dos primeros segmentos sean PLANTA
+        if (seg != NULL && seg->status == STATUS_PLANTA && seg->start_col == 0 &&
+            seg->next != NULL && seg->next->status == STATUS_PLANTA && seg->next->start_col == 1) {
+            printf("✓ TEST 7 PASADO: Agregar en segmento length=1 al inicio\n");
+        } else {
+            printf("✗ TEST 7 FALLADO: Estructura incorrecta en segmento length=1\n");
+        }
+    } else {
+        printf("✗ TEST 7 FALLADO: No se pudo agregar en segmento length=1\n");
+    }
+    
+    // TEST 8: Prueba avanzada de caso borde: plantar en un hueco (length=1) al final.
+    resetRow(board, 3);
+    gameBoardAddPlant(board, 3, 7); // Deja hueco en col 8
+    if (gameBoardAddPlant(board, 3, 8) == 1) { // Llena el hueco
+        RowSegment* seg = board->rows[3].first_segment;
+        while (seg != NULL && seg->next != NULL && seg->next->next != NULL) {
+            seg = seg->next; // Avanzo hasta el anteúltimo segmento
+        }
+        // Valida que los dos últimos segmentos sean PLANTA
+        if (seg != NULL && seg->status == STATUS_PLANTA && seg->start_col == 7 &&
+            seg->next != NULL && seg->next->status == STATUS_PLANTA && seg->next->start_col == 8) {
+            printf("✓ TEST 8 PASADO: Agregar en segmento length=1 al final\n");
+        } else {
+            printf("✗ TEST 8 FALLADO: Estructura incorrecta en segmento length=1 al final\n");
+        }
+    } else {
+        printf("✗ TEST 8 FALLADO: No se pudo agregar en segmento length=1 al final\n");
+    }
+    
+    // TEST 9: Prueba de robustez: verifica que planta_data (memoria anidada)
+    // se haya asignado e inicializado correctamente.
+    resetRow(board, 4);
+    if (gameBoardAddPlant(board, 4, 3) == 1) {
+        RowSegment* seg = board->rows[4].first_segment;
+        while (seg != NULL && seg->status != STATUS_PLANTA) {
+            seg = seg->next; // Busco el segmento planta
+        }
+        if (seg != NULL && seg->planta_data != NULL) {
+            // Verifico que los datos de la planta sean correctos
+            if (seg->planta_data->activo == 1 &&
+                seg->planta_data->rect.x == GRID_OFFSET_X + (3 * CELL_WIDTH) &&
+                seg->planta_data->rect.y == GRID_OFFSET_Y + (4 * CELL_HEIGHT)) {
+                printf("✓ TEST 9 PASADO: planta_data inicializada correctamente\n");
+            } else {
+                printf("✗ TEST 9 FALLADO: planta_data mal inicializada\n");
+            }
+        } else {
+            printf("✗ TEST 9 FALLADO: planta_data es NULL\n");
+        }
+    } else {
+        printf("✗ TEST 9 FALLADO: No se pudo agregar planta\n");
+    }
+    
+    // Libero toda la memoria usada en los tests
+    gameBoardDelete(board);
+    printf("========================================\n");
+    printf("Tests completados para gameBoardAddPlant\n");
+    printf("========================================\n\n");
+}
+
+
+
+
+
+// ========== TESTS gameBoardRemovePlant ==========
+
+
+/**
+ * Pruebas para gameBoardRemovePlant.
+ * La idea es validar la lógica de "fusión de segmentos",
+ * que es el problema central de esta función. Los tests
+ * cubren los casos mínimos de la consigna y varios
+ * casos borde (fusión al inicio, al final y triple).
+ */
+void testGameBoardRemovePlant() {
+    printf("\n========= TESTS gameBoardRemovePlant =========\n");
+
+    GameBoard* board = gameBoardNew();
+    if (board == NULL) {
+        printf("✗ Error al crear tablero para tests\n");
+        return;
+    }
+
+    // TEST 0: Pruebo la robustez ante inputs inválidos.
+    gameBoardRemovePlant(NULL, 0, 0);
+    gameBoardRemovePlant(board, -1, 0);
+    gameBoardRemovePlant(board, GRID_ROWS, 0);
+    gameBoardRemovePlant(board, 0, -1);
+    gameBoardRemovePlant(board, 0, GRID_COLS);
+    printf("✓ TEST 0 PASADO: Maneja inputs invalidos sin crash\n");
+
+    // TEST 1: Pruebo remover de una celda ya vacía.
+    // La lista de segmentos debe quedar intacta (1 solo nodo VACIO).
+    resetRow(board, 0);
+    gameBoardRemovePlant(board, 0, 4);
+    RowSegment* seg = board->rows[0].first_segment;
+    if (seg != NULL && seg->status == STATUS_VACIO && seg->start_col == 0 && 
+        seg->length == GRID_COLS && seg->next == NULL) {
+        printf("✓ TEST 1 PASADO: Remover en celda vacia no cambia nada\n");
+    } else {
+        printf("✗ TEST 1 FALLADO: Modifico estructura sin planta\n");
+    }
+
+    // TEST 2: Pruebo la Consigna 1 (Plantar 3, 4, 5 y sacar 4).
+    // Esto prueba que al sacar la planta del medio, se crea un hueco (VACIO, length=1)
+    // que NO se fusiona con sus vecinos (PLANTA).
+    resetRow(board, 0);
+    gameBoardAddPlant(board, 0, 3);
+    gameBoardAddPlant(board, 0, 4);
+    gameBoardAddPlant(board, 0, 5);
+    gameBoardRemovePlant(board, 0, 4);
+    
+    // Verifico el estado: PLANTA en 3, VACIO en 4, PLANTA en 5.
+    seg = board->rows[0].first_segment;
+    int found_plant_3 = 0, found_vacio_4 = 0, found_plant_5 = 0;
+    while (seg != NULL) {
+        if (seg->status == STATUS_PLANTA && seg->start_col == 3) found_plant_3 = 1;
+        if (seg->status == STATUS_VACIO && seg->start_col == 4 && seg->length == 1) found_vacio_4 = 1;
+        if (seg->status == STATUS_PLANTA && seg->start_col == 5) found_plant_5 = 1;
+        seg = seg->next;
+    }
+    
+    if (found_plant_3 && found_vacio_4 && found_plant_5) {
+        printf("✓ TEST 2 PASADO: Sacar planta del medio (no fusiona con plantas adyacentes)\n");
+    } else {
+        printf("✗ TEST 2 FALLADO: Estructura incorrecta al sacar planta del medio\n");
+    }
+
+    // TEST 3: Pruebo la Consigna 2 (Seguir del caso anterior y sacar 3).
+    // Estado actual: [VACIO 0-2] [PLANTA 3] [VACIO 4] [PLANTA 5] [VACIO 6-8]
+    // Al sacar 3, [VACIO 3] debe fusionarse con [VACIO 4] y con [VACIO 0-2].
+    // El resultado debe ser un gran segmento [VACIO 0-4].
+    gameBoardRemovePlant(board, 0, 3);
+    
+    seg = board->rows[0].first_segment;
+    int found_fused_vacio = 0;
+    int still_has_plant_5 = 0;
+    while (seg != NULL) {
+        // Busco un segmento VACIO que cubra el rango [0-4]
+        if (seg->status == STATUS_VACIO && seg->start_col == 0 && seg->length == 5) {
+            found_fused_vacio = 1;
+        }
+        if (seg->status == STATUS_PLANTA && seg->start_col == 5) {
+            still_has_plant_5 = 1;
+        }
+        seg = seg->next;
+    }
+    
+    if (found_fused_vacio && still_has_plant_5) {
+        printf("✓ TEST 3 PASADO: Fusion de segmentos vacios adyacentes (Triple Fusión)\n");
+    } else {
+        printf("✗ TEST 3 FALLADO: No fusiono correctamente segmentos vacios\n");
+    }
+
+    // TEST 4: Pruebo la Consigna 3 (Llenar fila y sacar del medio).
+    // Esto prueba que se crea un hueco (VACIO, length=1) aislado entre Plantas.
+    resetRow(board, 1);
+    for (int c = 0; c < GRID_COLS; c++) {
+        gameBoardAddPlant(board, 1, c);
+    }
+    gameBoardRemovePlant(board, 1, 4); // Saco la del medio
+    
+    seg = board->rows[1].first_segment;
+    int plant_count = 0;
+    int has_vacio_at_4 = 0;
+    while (seg != NULL) {
+        if (seg->status == STATUS_PLANTA) plant_count++;
+        if (seg->status == STATUS_VACIO && seg->start_col == 4 && seg->length == 1) {
+            has_vacio_at_4 = 1;
+        }
+        seg = seg->next;
+    }
+    
+    if (plant_count == 8 && has_vacio_at_4) {
+        printf("✓ TEST 4 PASADO: Llenar fila y sacar del medio\n");
+    } else {
+        printf("✗ TEST 4 FALLADO: Error al sacar planta de fila llena\n");
+    }
+
+    // TEST 5: Prueba avanzada: Remover planta aislada (Triple Fusión).
+    // Planto en 4 (VACIO 0-3, PLANTA 4, VACIO 5-8).
+    // Al remover 4, los 3 segmentos deben fusionarse en uno solo (VACIO 0-8).
+    resetRow(board, 2);
+    gameBoardAddPlant(board, 2, 4);
+    gameBoardRemovePlant(board, 2, 4);
+    
+    seg = board->rows[2].first_segment;
+    if (seg != NULL && seg->status == STATUS_VACIO && seg->start_col == 0 && 
+        seg->length == GRID_COLS && seg->next == NULL) {
+        printf("✓ TEST 5 PASADO: Remover planta aislada (triple fusion)\n");
+    } else {
+        printf("✗ TEST 5 FALLADO: No fusiono correctamente en fila vacia\n");
+    }
+
+    // TEST 6: Prueba avanzada: Fusión al inicio.
+    // Planto en 0 (PLANTA 0, VACIO 1-8).
+    // Al remover 0, debe fusionarse con el segmento 'next' y quedar (VACIO 0-8).
+    resetRow(board, 2);
+    gameBoardAddPlant(board, 2, 0);
+    gameBoardRemovePlant(board, 2, 0);
+    
+    seg = board->rows[2].first_segment;
+    if (seg != NULL && seg->status == STATUS_VACIO && seg->start_col == 0 && 
+        seg->length == GRID_COLS && seg->next == NULL) {
+        printf("✓ TEST 6 PASADO: Remover al inicio y fusionar\n");
+    } else {
+        printf("✗ TEST 6 FALLADO: No fusiono al remover del inicio\n");
+    }
+
+    // TEST 7: Prueba avanzada: Fusión al final.
+    // Planto en 8 (VACIO 0-7, PLANTA 8).
+    // Al remover 8, debe fusionarse con el segmento 'prev' y quedar (VACIO 0-8).
+    resetRow(board, 3);
+    gameBoardAddPlant(board, 3, 8);
+    gameBoardRemovePlant(board, 3, 8);
+    
+    seg = board->rows[3].first_segment;
+    if (seg != NULL && seg->status == STATUS_VACIO && seg->start_col == 0 && 
+        seg->length == GRID_COLS && seg->next == NULL) {
+        printf("✓ TEST 7 PASADO: Remover al final y fusionar\n");
+    } else {
+        printf("✗ TEST 7 FALLADO: No fusiono al remover del final\n");
+    }
+
+    // TEST 8: Prueba avanzada: Fusiones múltiples complejas.
+    resetRow(board, 4);
+    // Dejo huecos en columnas impares
+    for (int c = 0; c < GRID_COLS; c += 2) {
+        gameBoardAddPlant(board, 4, c);
+    }
+    // Remuevo plantas para forzar fusiones
+    gameBoardRemovePlant(board, 4, 0);  // Fusiona con [VACIO 1]
+    gameBoardRemovePlant(board, 4, 2);  // Fusiona [VACIO 0-1] con [VACIO 2] y [VACIO 3]
+    
+    seg = board->rows[4].first_segment;
+    int found_large_vacio = 0;
+    while (seg != NULL) {
+        if (seg->status == STATUS_VACIO && seg->start_col == 0 && seg->length == 4) {
+            found_large_vacio = 1; // Debería existir un [VACIO 0-3]
+        }
+        seg = seg->next;
+    }
+    
+    if (found_large_vacio) {
+        printf("✓ TEST 8 PASADO: Fusiones multiples complejas\n");
+    } else {
+        printf("✗ TEST 8 FALLADO: No manejo fusiones complejas\n");
+    }
+
+    // TEST 9: Stress test: Llenar y vaciar la fila.
+    // Esto asegura que la lógica de fusión es robusta y puede
+    // devolver la fila a su estado inicial (1 solo segmento VACIO).
+    resetRow(board, 4);
+    for (int c = 0; c < GRID_COLS; c++) {
+        gameBoardAddPlant(board, 4, c);
+    }
+    for (int c = GRID_COLS - 1; c >= 0; c--) { // Vacio de derecha a izquierda
+        gameBoardRemovePlant(board, 4, c);
+    }
+    
+    seg = board->rows[4].first_segment;
+    if (seg != NULL && seg->status == STATUS_VACIO && seg->start_col == 0 && 
+        seg->length == GRID_COLS && seg->next == NULL) {
+        printf("✓ TEST 9 PASADO: Stress test - volver a fila vacia\n");
+    } else {
+        printf("✗ TEST 9 FALLADO: No volvio a estado inicial\n");
+    }
+
+    gameBoardDelete(board);
+    printf("========================================\n");
+    printf("Tests completados para gameBoardRemovePlant\n");
+    printf("========================================\n\n");
+}
+
+
+
+
+
+
+// ========== TESTS gameBoardAddZombie ==========
+
+
+/**
+ * Pruebas para gameBoardAddZombie.
+ * La idea es validar que la inserción en la lista de zombies
+ * funcione, cumpla con los casos de la consigna (escalabilidad)
+ * y que los datos se inicialicen correctamente.
+ */
+void testGameBoardAddZombie() {
+    printf("\n========= TESTS gameBoardAddZombie =========\n");
+    
+    // TEST 0: Pruebo la robustez de la función ante inputs inválidos.
+    GameBoard* board = gameBoardNew();
+    if (board == NULL) {
+        printf("✗ Error al crear tablero para tests\n");
+        return;
+    }
+    
+    // Pruebo con board NULL y filas fuera de rango
+    gameBoardAddZombie(NULL, 0);
+    gameBoardAddZombie(board, -1);
+    gameBoardAddZombie(board, GRID_ROWS);
+    
+    // Verifico que la lista siga vacía
+    int all_empty = 1;
+    for (int i = 0; i < GRID_ROWS; i++) {
+        if (board->rows[i].first_zombie != NULL) {
+            all_empty = 0;
+            break;
+        }
+    }
+    
+    if (all_empty) {
+        printf("✓ TEST 0 PASADO: Maneja inputs invalidos sin agregar zombies\n");
+    } else {
+        printf("✗ TEST 0 FALLADO: Agrego zombie con input invalido\n");
+    }
+    
+    // TEST 1: Pruebo la Consigna 1 (Agregar a lista existente).
+    // Agrego 3 zombies y cuento. Luego agrego 1 más y vuelvo a contar.
+    int test_row = 2;
+    for (int i = 0; i < 3; i++) {
+        gameBoardAddZombie(board, test_row);
+    }
+    
+    int count = 0;
+    ZombieNode* current = board->rows[test_row].first_zombie;
+    while (current != NULL) {
+        count++;
+        current = current->next;
+    }
+    
+    if (count == 3) {
+        gameBoardAddZombie(board, test_row); // Agrego el cuarto
+        
+        count = 0;
+        current = board->rows[test_row].first_zombie;
+        while (current != NULL) {
+            count++;
+            current = current->next;
+        }
+        
+        if (count == 4) {
+            printf("✓ TEST 1 PASADO: Tomar lista de 3 zombies y agregar 1 mas\n");
+        } else {
+            printf("✗ TEST 1 FALLADO: Esperados 4, encontrados %d\n", count);
+        }
+    } else {
+        printf("✗ TEST 1 FALLADO: No se crearon los 3 zombies iniciales\n");
+    }
+    
+    // TEST 2: Pruebo la Consigna 2 (Test de escalabilidad).
+    // La idea es verificar que la lista enlazada puede crecer
+    // mucho más que un array estático, probando con 10000 nodos.
+    printf("TEST 2: Creando 10000 zombies (puede tomar un momento)...\n");
+    
+    gameBoardDelete(board);
+    board = gameBoardNew();
+    if (board == NULL) {
+        printf("✗ Error al recrear tablero\n");
+        return;
+    }
+    
+    int large_count = 10000;
+    int row_test = 1;
+    
+    for (int i = 0; i < large_count; i++) {
+        gameBoardAddZombie(board, row_test);
+    }
+    
+    // Cuento los zombies agregados
+    count = 0;
+    current = board->rows[row_test].first_zombie;
+    while (current != NULL && count <= large_count) {
+        count++;
+        current = current->next;
+    }
+    
+    if (count == large_count) {
+        printf("✓ TEST 2 PASADO: Crear lista de 10000 zombies\n");
+    } else {
+        printf("✗ TEST 2 FALLADO: Esperados %d, encontrados %d\n", large_count, count);
+    }
+    
+    // TEST 3: Prueba avanzada: Verifico la inicialización de datos.
+    // Me aseguro que un zombie nuevo tenga los valores correctos
+    // (vida, posición, estado, etc.).
+    gameBoardDelete(board);
+    board = gameBoardNew();
+    if (board == NULL) {
+        printf("✗ Error al recrear tablero\n");
+        return;
+    }
+    
+    gameBoardAddZombie(board, 0);
+    ZombieNode* zombie = board->rows[0].first_zombie;
+    
+    if (zombie != NULL) {
+        int init_ok = 1;
+        if (zombie->zombie_data.vida != 100) init_ok = 0;
+        if (zombie->zombie_data.activo != 1) init_ok = 0;
+        if (zombie->zombie_data.row != 0) init_ok = 0;
+        if (zombie->zombie_data.pos_x != INT_TO_FX(SCREEN_WIDTH)) init_ok = 0;
+        
+        if (init_ok) {
+            printf("✓ TEST 3 PASADO: Zombie inicializado correctamente\n");
+        } else {
+            printf("✗ TEST 3 FALLADO: Inicializacion incorrecta\n");
+        }
+    } else {
+        printf("✗ TEST 3 FALLADO: No se creo el zombie\n");
+    }
+    
+    // TEST 4: Prueba avanzada: Verifico la independencia de las filas.
+    // Agrego zombies en distintas filas y me aseguro que no se mezclen.
+    gameBoardDelete(board);
+    board = gameBoardNew();
+    if (board == NULL) {
+        printf("✗ Error al recrear tablero\n");
+        return;
+    }
+    
+    gameBoardAddZombie(board, 0);
+    gameBoardAddZombie(board, 2);
+    gameBoardAddZombie(board, 4);
+    
+    int test4_ok = 1;
+    for (int i = 0; i < GRID_ROWS; i++) {
+        int expected = (i == 0 || i == 2 || i == 4) ? 1 : 0;
+        
+        count = 0;
+        current = board->rows[i].first_zombie;
+        while (current != NULL) {
+            count++;
+            current = current->next;
+        }
+        
+        if (count != expected) test4_ok = 0;
+    }
+    
+    if (test4_ok) {
+        printf("✓ TEST 4 PASADO: Zombies en filas independientes\n");
+    } else {
+        printf("✗ TEST 4 FALLADO: Error en distribucion por filas\n");
+    }
+    
+    // TEST 5: Prueba avanzada: Verifico la lógica de inserción (LIFO).
+    // La función debe insertar al *principio* de la lista (head insertion).
+    gameBoardDelete(board);
+    board = gameBoardNew();
+    if (board == NULL) {
+        printf("✗ Error al recrear tablero\n");
+        return;
+    }
+    
+    // Agrego 3 zombies con vidas distintas para identificarlos
+    gameBoardAddZombie(board, 3);
+    board->rows[3].first_zombie->zombie_data.vida = 50;  // 1ro
+    gameBoardAddZombie(board, 3);
+    board->rows[3].first_zombie->zombie_data.vida = 75;  // 2do
+    gameBoardAddZombie(board, 3);
+    board->rows[3].first_zombie->zombie_data.vida = 90;  // 3ro (debe ser el 1ro en la lista)
+    
+    // Verifico el orden: 90 -> 75 -> 50
+    current = board->rows[3].first_zombie;
+    if (current && current->zombie_data.vida == 90 &&
+        current->next && current->next->zombie_data.vida == 75 &&
+        current->next->next && current->next->next->zombie_data.vida == 50) {
+        printf("✓ TEST 5 PASADO: Zombies se agregan al inicio (LIFO)\n");
+    } else {
+        printf("✗ TEST 5 FALLADO: Orden incorrecto en la lista\n");
+    }
+    
+    gameBoardDelete(board);
+    printf("========================================\n");
+    printf("Tests completados para gameBoardAddZombie\n");
+    printf("========================================\n\n");
+}
+
+
+
+
+// ========== TESTS gameBoardAddZombies ==========
+
+
+/**
+ * Pruebas para gameBoardAddZombies.
+ * La idea es validar que el spawn en bloque deje la fila igual que
+ * si se hubiera llamado a gameBoardAddZombie varias veces, y que
+ * los nodos de los zombies muertos se reutilicen desde el pool.
+ */
+void testGameBoardAddZombies() {
+    printf("\n========= TESTS gameBoardAddZombies =========\n");
+
+    GameBoard* board = gameBoardNew();
+    if (board == NULL) {
+        printf("✗ Error al crear tablero para tests\n");
+        return;
+    }
+
+    // TEST 0: Pruebo la robustez ante inputs inválidos
+    if (gameBoardAddZombies(NULL, 0, 5, 10) == 0 &&
+        gameBoardAddZombies(board, -1, 5, 10) == 0 &&
+        gameBoardAddZombies(board, GRID_ROWS, 5, 10) == 0 &&
+        gameBoardAddZombies(board, 0, 0, 10) == 0 &&
+        board->rows[0].first_zombie == NULL) {
+        printf("✓ TEST 0 PASADO: Maneja inputs invalidos sin agregar zombies\n");
+    } else {
+        printf("✗ TEST 0 FALLADO: No maneja inputs invalidos\n");
+    }
+
+    // TEST 1: Pruebo una oleada de 500 zombies con separación de 10px.
+    // El orden debe ser LIFO: el de más atrás primero en la lista.
+    int agregados = gameBoardAddZombies(board, 2, 500, 10);
+    int count = 0;
+    int orden_ok = 1;
+    ZombieNode* current = board->rows[2].first_zombie;
+    ZombieNode* anterior = NULL;
+    while (current != NULL) {
+        int esperado = INT_TO_FX(SCREEN_WIDTH + (499 - count) * 10);
+        if (current->zombie_data.pos_x != esperado || current->prev != anterior) {
+            orden_ok = 0;
+        }
+        count++;
+        anterior = current;
+        current = current->next;
+    }
+    if (agregados == 500 && count == 500 && orden_ok) {
+        printf("✓ TEST 1 PASADO: Oleada de 500 zombies en orden\n");
+    } else {
+        printf("✗ TEST 1 FALLADO: Esperados 500 en orden, encontrados %d\n", count);
+    }
+
+    // TEST 2: Pruebo que el de más adelante sea el primero de la oleada
+    ZombieNode* front = board->rows[2].front_zombie;
+    if (front != NULL && front->zombie_data.pos_x == INT_TO_FX(SCREEN_WIDTH) && front->next == NULL) {
+        printf("✓ TEST 2 PASADO: front_zombie es el primero de la oleada\n");
+    } else {
+        printf("✗ TEST 2 FALLADO: front_zombie incorrecto\n");
+    }
+
+    // TEST 3: Pruebo que un nodo liberado se reutilice desde el pool
+    ZombieNode* muerto = board->rows[2].first_zombie;
+    removeZombieNode(board, 2, muerto);
+    gameBoardAddZombie(board, 4);
+    if (board->rows[4].first_zombie == muerto) {
+        printf("✓ TEST 3 PASADO: Reutiliza el nodo de un zombie muerto\n");
+    } else {
+        printf("✗ TEST 3 FALLADO: No reutilizo el nodo liberado\n");
+    }
+
+    gameBoardDelete(board);
+    printf("========================================\n");
+    printf("Tests completados para gameBoardAddZombies\n");
+    printf("========================================\n\n");
+}
+
+
+
+// ========== TESTS ZOMBIE HANDLES ==========
+
+
+/**
+ * Pruebas para gameBoardGetZombieHandle y gameBoardGetZombie.
+ * La idea es validar que un handle encuentre a su zombie mientras
+ * vive y que quede vencido cuando muere, incluso si el nodo se
+ * reutiliza para otro zombie.
+ */
+void testZombieHandles() {
+    printf("\n========= TESTS zombie handles =========\n");
+
+    GameBoard* board = gameBoardNew();
+    if (board == NULL) {
+        printf("✗ Error al crear tablero para tests\n");
+        return;
+    }
+
+    // TEST 0: Pruebo la robustez ante inputs inválidos
+    ZombieHandle invalido = gameBoardGetZombieHandle(NULL);
+    ZombieHandle fuera_de_rango = {1000, 0};
+    if (gameBoardGetZombie(NULL, invalido) == NULL &&
+        gameBoardGetZombie(board, invalido) == NULL &&
+        gameBoardGetZombie(board, fuera_de_rango) == NULL) {
+        printf("✓ TEST 0 PASADO: Handles invalidos devuelven NULL\n");
+    } else {
+        printf("✗ TEST 0 FALLADO: Handle invalido encontro un zombie\n");
+    }
+
+    // TEST 1: Pruebo que el handle encuentre al zombie entre varios
+    gameBoardAddZombies(board, 1, 100, 5);
+    ZombieNode* elegido = board->rows[1].first_zombie->next->next;
+    ZombieHandle handle = gameBoardGetZombieHandle(elegido);
+    gameBoardAddZombies(board, 3, 100, 5); // Más zombies no mueven al elegido
+    if (gameBoardGetZombie(board, handle) == elegido) {
+        printf("✓ TEST 1 PASADO: El handle encuentra a su zombie\n");
     } else {
-        printf("✗ TEST 5 FALLADO: El duplicado apunta al mismo lugar que el original\n");
+        printf("✗ TEST 1 FALLADO: El handle no encontro a su zombie\n");
     }
-    free(test5_dup);
-    
-    printf("======================================\n\n");
 
-    // TEST 6: Pruebo la robustez de la función ante un NULL
-    char* test6_dup = strDuplicate(NULL);
-    if (test6_dup == NULL) {
-        printf("✓ TEST 6 PASADO: NULL input retorna NULL\n");
+    // TEST 2: Pruebo que al morir el zombie el handle quede vencido,
+    // aunque su nodo se reutilice para un zombie nuevo
+    removeZombieNode(board, 1, elegido);
+    int vencido = (gameBoardGetZombie(board, handle) == NULL);
+    gameBoardAddZombie(board, 0);
+    ZombieNode* nuevo = board->rows[0].first_zombie;
+    if (vencido && nuevo == elegido && gameBoardGetZombie(board, handle) == NULL &&
+        gameBoardGetZombie(board, gameBoardGetZombieHandle(nuevo)) == nuevo) {
+        printf("✓ TEST 2 PASADO: Handle vencido detectado tras reutilizar el nodo\n");
     } else {
-        printf("✗ TEST 6 FALLADO: NULL input no manejado correctamente\n");
-        free(test6_dup);
+        printf("✗ TEST 2 FALLADO: Handle vencido no detectado\n");
     }
+
+    gameBoardDelete(board);
+    printf("========================================\n");
+    printf("Tests completados para zombie handles\n");
+    printf("========================================\n\n");
 }
 
 
 
-// ========== TESTS STR COMPARE ==========
+// ========== TESTS ARVEJAS ==========
 
 
 /**
- * Pruebas para strCompare.
- * El objetivo es validar la lógica de comparación lexicográfica
- * y los valores de retorno pedidos por la consigna (0, 1, -1).
+ * Pruebas para el array dinámico de arvejas.
+ * La idea es validar que el array crezca cuando se llena en lugar de
+ * perder disparos, que se mantenga compacto al sacar arvejas, que la
+ * reserva previa funcione y que se registre el máximo en vuelo.
  */
-void testStrCompare() {
-    printf("\n========= TESTS strCompare =========\n");
-    
-    // TEST 1: Pruebo el caso base: dos strings vacíos
-    char* test1_s1 = "";
-    char* test1_s2 = "";
-    int result1 = strCompare(test1_s1, test1_s2);
-    if (result1 == 0) {
-        printf("✓ TEST 1 PASADO: Dos strings vacios son iguales\n");
-    } else {
-        printf("✗ TEST 1 FALLADO: Dos strings vacios deberian ser iguales (resultado: %d)\n", result1);
+void testArvejas() {
+    printf("\n========= TESTS arvejas =========\n");
+
+    GameBoard* board = gameBoardNew();
+    if (board == NULL) {
+        printf("✗ Error al crear tablero para tests\n");
+        return;
     }
-    
-    // TEST 2: Pruebo igualdad con un carácter
-    char* test2_s1 = "A";
-    char* test2_s2 = "A";
-    int result2 = strCompare(test2_s1, test2_s2);
-    if (result2 == 0) {
-        printf("✓ TEST 2 PASADO: Dos strings de un caracter iguales\n");
+
+    // TEST 1: Pruebo disparar más arvejas que la capacidad inicial
+    Planta* p = createPlanta(0, 0);
+    if (p == NULL) {
+        gameBoardDelete(board);
+        return;
+    }
+    gameBoardAddZombie(board, 0); // Sin zombies en la fila la planta no dispara
+    int disparos = ARVEJAS_INICIALES * 3 + 1;
+    for (int i = 0; i < disparos; i++) {
+        dispararArveja(board, p, 0);
+    }
+    if (board->arvejas_descartadas == 0 && board->arvejas_capacidad >= disparos &&
+        board->arvejas_max_activas == disparos) {
+        printf("✓ TEST 1 PASADO: El array crece sin descartar disparos\n");
     } else {
-        printf("✗ TEST 2 FALLADO: Dos strings de un caracter iguales (resultado: %d)\n", result2);
+        printf("✗ TEST 1 FALLADO: Descartadas %d, capacidad %d, maximo %d\n",
+               board->arvejas_descartadas, board->arvejas_capacidad, board->arvejas_max_activas);
     }
-    
-    // TEST 3: Pruebo (s1 < s2)
-    char* test3_s1 = "abc";
-    char* test3_s2 = "abd";
-    int result3 = strCompare(test3_s1, test3_s2);
-    if (result3 == 1) { // Consigna pide 1
-        printf("✓ TEST 3 PASADO: 'abc' es menor que 'abd'\n");
+
+    // TEST 2: Pruebo que liberar del medio deje el array compacto y el
+    // bucket de la fila apuntando bien a la arveja que se movió
+    int capacidad = board->arvejas_capacidad;
+    liberarArveja(board, 5);
+    int compacto_ok = (board->cant_arvejas == disparos - 1 &&
+                       board->rows[0].cant_arvejas == disparos - 1);
+    for (int k = 0; k < board->rows[0].cant_arvejas; k++) {
+        int i = board->rows[0].indices_arvejas[k];
+        if (i >= board->cant_arvejas || board->arvejas[i].pos_en_fila != k) {
+            compacto_ok = 0;
+        }
+    }
+    dispararArveja(board, p, 0);
+    if (compacto_ok && board->cant_arvejas == disparos &&
+        board->arvejas_capacidad == capacidad && board->arvejas_max_activas == disparos) {
+        printf("✓ TEST 2 PASADO: Liberar mantiene el array compacto\n");
     } else {
-        printf("✗ TEST 3 FALLADO: 'abc' deberia ser menor que 'abd' (resultado: %d)\n", result3);
+        printf("✗ TEST 2 FALLADO: El array no quedo compacto\n");
     }
-    
-    // TEST 4: Pruebo (s1 > s2)
-    char* test4_s1 = "abd";
-    char* test4_s2 = "abc";
-    int result4 = strCompare(test4_s1, test4_s2);
-    if (result4 == -1) { // Consigna pide -1
-        printf("✓ TEST 4 PASADO: 'abd' es mayor que 'abc'\n");
+    free(p);
+    gameBoardDelete(board);
+
+    // TEST 3: Pruebo la reserva previa
+    board = gameBoardNew();
+    if (board == NULL) {
+        printf("✗ Error al recrear tablero\n");
+        return;
+    }
+    if (gameBoardReserveArvejas(NULL, 10) == 0 &&
+        gameBoardReserveArvejas(board, 1000) == 1 &&
+        board->arvejas_capacidad >= 1000 && board->cant_arvejas == 0) {
+        printf("✓ TEST 3 PASADO: Reserva previa de arvejas\n");
     } else {
-        printf("✗ TEST 4 FALLADO: 'abd' deberia ser mayor que 'abc' (resultado: %d)\n", result4);
+        printf("✗ TEST 3 FALLADO: La reserva previa no funciono\n");
     }
-    
-    // TEST 5: Pruebo strings diferentes (s1 < s2)
-    char* test5_s1 = "apple";
-    char* test5_s2 = "banana";
-    int result5 = strCompare(test5_s1, test5_s2);
-    if (result5 == 1) { 
-        printf("✓ TEST 5 PASADO: 'apple' es menor que 'banana'\n");
+
+    // TEST 4: Pruebo que el paso por bloques dé lo mismo que el escalar
+    // (posiciones y máscara de salidas), con cantidades que no llenan el
+    // último bloque y arvejas cruzando el borde de la pantalla
+    enum { MAX_PASO = 1023 };
+    static int xs_bloques[MAX_PASO], xs_escalar[MAX_PASO], filas[MAX_PASO];
+    int cantidades[] = {0, 1, 3, 4, 5, 7, 9, MAX_PASO};
+    int paso_ok = 1;
+    int salidas_vistas = 0;
+    for (int c = 0; c < (int)(sizeof(cantidades) / sizeof(cantidades[0])); c++) {
+        int cantidad = cantidades[c];
+        for (int i = 0; i < cantidad; i++) {
+            xs_bloques[i] = INT_TO_FX(SCREEN_WIDTH - 20) + i * 1237 + (i % 3) * INT_TO_FX(7);
+            xs_escalar[i] = xs_bloques[i];
+            filas[i] = (i * 7) % GRID_ROWS;
+        }
+        for (int t = 0; t < 8; t++) {
+            int mascara_bloques = avanzarArvejas(xs_bloques, filas, cantidad);
+            int mascara_escalar = avanzarArvejasEscalar(xs_escalar, filas, cantidad);
+            if (mascara_bloques != mascara_escalar) paso_ok = 0;
+            salidas_vistas |= mascara_escalar;
+            for (int i = 0; i < cantidad; i++) {
+                if (xs_bloques[i] != xs_escalar[i]) paso_ok = 0;
+            }
+        }
+    }
+    // Justo en el borde: las pares (fila 0) pasan a x = SCREEN_WIDTH + 1 y
+    // salen, las impares (fila 1) quedan en SCREEN_WIDTH. Sin cola, así la
+    // máscara sale entera del paso por bloques
+    int enteros = MAX_PASO - 3;
+    for (int i = 0; i < enteros; i++) {
+        xs_bloques[i] = INT_TO_FX(SCREEN_WIDTH + 1) - PEA_SPEED_FX - (i % 2);
+        xs_escalar[i] = xs_bloques[i];
+        filas[i] = i % 2;
+    }
+    if (avanzarArvejas(xs_bloques, filas, enteros) != 1 ||
+        avanzarArvejasEscalar(xs_escalar, filas, enteros) != 1) {
+        paso_ok = 0;
+    }
+    if (paso_ok && salidas_vistas == (1 << GRID_ROWS) - 1) {
+        printf("✓ TEST 4 PASADO: El paso por bloques coincide con el escalar\n");
     } else {
-        printf("✗ TEST 5 FALLADO: 'apple' deberia ser menor que 'banana' (resultado: %d)\n", result5);
+        printf("✗ TEST 4 FALLADO: El paso por bloques difiere del escalar\n");
     }
-    
-    // TEST 6: Pruebo strings diferentes (s1 > s2)
-    char* test6_s1 = "banana";
-    char* test6_s2 = "apple";
-    int result6 = strCompare(test6_s1, test6_s2);
-    if (result6 == -1) { 
-        printf("✓ TEST 6 PASADO: 'banana' es mayor que 'apple'\n");
+
+    gameBoardDelete(board);
+    printf("========================================\n");
+    printf("Tests completados para arvejas\n");
+    printf("========================================\n\n");
+}
+
+
+
+// ========== TESTS arvejaTocaZombie ==========
+
+
+/**
+ * Pruebas para arvejaTocaZombie.
+ * La idea es validar que el kernel 1D dé exactamente lo mismo que
+ * SDL_HasIntersection para una arveja y un zombie de la misma fila,
+ * barriendo la arveja de punta a punta (incluyendo los bordes justos).
+ */
+void testArvejaTocaZombie() {
+    printf("\n========= TESTS arvejaTocaZombie =========\n");
+
+    int diferencias = 0;
+    int pruebas = 0;
+    for (int row = 0; row < GRID_ROWS; row++) {
+        SDL_Rect zombie = {500, GRID_OFFSET_Y + row * CELL_HEIGHT, CELL_WIDTH, CELL_HEIGHT};
+        for (int x = 500 - 40; x <= 500 + CELL_WIDTH + 20; x++) {
+            SDL_Rect arveja = {x, GRID_OFFSET_Y + row * CELL_HEIGHT + CELL_HEIGHT / 4, 20, 20};
+            int esperado = SDL_HasIntersection(&arveja, &zombie) ? 1 : 0;
+            if (arvejaTocaZombie(&arveja, &zombie) != esperado) {
+                diferencias++;
+            }
+            pruebas++;
+        }
+    }
+
+    if (diferencias == 0) {
+        printf("✓ TEST 1 PASADO: Coincide con SDL_HasIntersection en %d casos\n", pruebas);
     } else {
-        printf("✗ TEST 6 FALLADO: 'banana' deberia ser mayor que 'apple' (resultado: %d)\n", result6);
+        printf("✗ TEST 1 FALLADO: %d diferencias con SDL_HasIntersection\n", diferencias);
     }
-    
-    // TEST 7: Pruebo el caso de prefijo (s1 < s2)
-    char* test7_s1 = "test";
-    char* test7_s2 = "testing";
-    int result7 = strCompare(test7_s1, test7_s2);
-    if (result7 == 1) { 
-        printf("✓ TEST 7 PASADO: 'test' es menor que 'testing'\n");
+    printf("========================================\n");
+    printf("Tests completados para arvejaTocaZombie\n");
+    printf("========================================\n\n");
+}
+
+
+
+// ========== TESTS gameBoardIsGameOver ==========
+
+
+/**
+ * Zombie de menor pos_x de una fila, recorriendo toda la lista (para
+ * comparar con front_zombie, que el board mantiene sin recorrer).
+ */
+static ZombieNode* zombieDeMenorX(GardenRow* fila) {
+    ZombieNode* menor = NULL;
+    for (ZombieNode* z_node = fila->first_zombie; z_node != NULL; z_node = z_node->next) {
+        if (menor == NULL || z_node->zombie_data.pos_x < menor->zombie_data.pos_x) {
+            menor = z_node;
+        }
+    }
+    return menor;
+}
+
+/**
+ * Pruebas para gameBoardIsGameOver.
+ * La idea es validar que el zombie de más adelante de cada fila
+ * (front_zombie) se mantenga correcto al agregar y al sacar zombies,
+ * que es lo que permite responder el game over mirando un valor por fila.
+ */
+void testGameBoardIsGameOver() {
+    printf("\n========= TESTS gameBoardIsGameOver =========\n");
+
+    GameBoard* board = gameBoardNew();
+    if (board == NULL) {
+        printf("✗ Error al crear tablero para tests\n");
+        return;
+    }
+
+    // TEST 0: Pruebo la robustez ante NULL y un tablero vacío
+    if (gameBoardIsGameOver(NULL) == 0 && gameBoardIsGameOver(board) == 0) {
+        printf("✓ TEST 0 PASADO: NULL y tablero vacio no son game over\n");
     } else {
-        printf("✗ TEST 7 FALLADO: 'test' deberia ser menor que 'testing' (resultado: %d)\n", result7);
+        printf("✗ TEST 0 FALLADO: Game over sin zombies\n");
     }
-    
-    printf("====================================\n\n");
 
-    // TEST 8: Pruebo el caso de prefijo (s1 > s2)
-    char* test8_s1 = "testing";
-    char* test8_s2 = "test";
-    int result8 = strCompare(test8_s1, test8_s2);
-    if (result8 == -1) { 
-        printf("✓ TEST 8 PASADO: 'testing' es mayor que 'test'\n");
+    // TEST 1: Pruebo que front_zombie sea el de menor pos_x. La oleada
+    // queda en parte fuera de pantalla, así que el zombie suelto que
+    // agrego después spawnea ADELANTE de varios de ella
+    gameBoardAddZombies(board, 1, 4, 60);
+    gameBoardUpdate(board);
+    gameBoardAddZombie(board, 1);
+    if (board->rows[1].front_zombie == zombieDeMenorX(&board->rows[1]) &&
+        board->rows[1].front_zombie == board->rows[1].zombies_por_x[board->rows[1].inicio_zombies]) {
+        printf("✓ TEST 1 PASADO: front_zombie es el de menor pos_x\n");
     } else {
-        printf("✗ TEST 8 FALLADO: 'testing' deberia ser mayor que 'test' (resultado: %d)\n", result8);
+        printf("✗ TEST 1 FALLADO: front_zombie incorrecto\n");
     }
 
-    // TEST 9: Pruebo la sensibilidad a mayúsculas
-    char* test9_s1 = "A";
-    char* test9_s2 = "a";
-    int result9 = strCompare(test9_s1, test9_s2);
-    if (result9 == 1) { 
-        printf("✓ TEST 9 PASADO: 'A' < 'a'\n");
+    // TEST 2: Pruebo que al sacar el de adelante se recalcule el siguiente
+    ZombieNode* viejo = board->rows[1].front_zombie;
+    removeZombieNode(board, 1, viejo);
+    ZombieNode* front = board->rows[1].front_zombie;
+    if (front != NULL && front != viejo && front == zombieDeMenorX(&board->rows[1])) {
+        printf("✓ TEST 2 PASADO: front_zombie se recalcula al sacar el de adelante\n");
     } else {
-        printf("✗ TEST 9 FALLADO: 'A' deberia ser menor que 'a' (resultado: %d)\n", result9);
+        printf("✗ TEST 2 FALLADO: front_zombie no se recalculo\n");
     }
 
-    // TEST 10: Pruebo la robustez de la función ante NULLs
-    int result10a = strCompare(NULL, NULL);  // 0
-    int result10b = strCompare(NULL, "a");   // 1
-    int result10c = strCompare("a", NULL);   // -1
-    if (result10a == 0 && result10b == 1 && result10c == -1) {
-        printf("✓ TEST 10 PASADO: Manejo de NULL\n");
+    // TEST 3: Pruebo la condición de game over (misma que el juego base):
+    // dejo caminar a los zombies hasta la casa
+    int antes_ok = 1;
+    int ticks = 0;
+    while (!gameBoardIsGameOver(board) && ticks < 20000) {
+        gameBoardUpdate(board);
+        ticks++;
+        Zombie* z = &zombieDeMenorX(&board->rows[1])->zombie_data;
+        if (!gameBoardIsGameOver(board) && z->rect.x < GRID_OFFSET_X - z->rect.w) {
+            antes_ok = 0; // Uno ya llegó y no se detectó
+        }
+    }
+    Zombie* llego = &board->rows[1].front_zombie->zombie_data;
+    if (antes_ok && gameBoardIsGameOver(board) == 1 && llego->rect.x < GRID_OFFSET_X - llego->rect.w) {
+        printf("✓ TEST 3 PASADO: Zombie en la casa es game over\n");
     } else {
-        printf("✗ TEST 10 FALLADO: Manejo de NULL incorrecto\n");
+        printf("✗ TEST 3 FALLADO: No detecto el game over\n");
     }
+
+    gameBoardDelete(board);
+    printf("========================================\n");
+    printf("Tests completados para gameBoardIsGameOver\n");
+    printf("========================================\n\n");
 }
 
 
 
+// ========== TESTS MODO EVENTOS ==========
 
-// ========== TESTS STR CONCATENATE ==========
 
+/**
+ * Compara lo que se ve de dos tableros: tick, zombies (posición y vida)
+ * y arvejas de cada fila, en orden.
+ */
+static int mismoEstado(GameBoard* a, GameBoard* b) {
+    if (a->tick != b->tick || a->cant_arvejas != b->cant_arvejas) {
+        return 0;
+    }
+    for (int r = 0; r < GRID_ROWS; r++) {
+        GardenRow* fa = &a->rows[r];
+        GardenRow* fb = &b->rows[r];
+        if (fa->zombies_activos != fb->zombies_activos || fa->cant_arvejas != fb->cant_arvejas) {
+            return 0;
+        }
+        ZombieNode* za = fa->first_zombie;
+        ZombieNode* zb = fb->first_zombie;
+        for (; za != NULL && zb != NULL; za = za->next, zb = zb->next) {
+            if (za->zombie_data.pos_x != zb->zombie_data.pos_x ||
+                za->zombie_data.rect.x != zb->zombie_data.rect.x ||
+                za->zombie_data.vida != zb->zombie_data.vida) {
+                return 0;
+            }
+        }
+        for (int k = 0; k < fa->cant_arvejas; k++) {
+            if (a->arvejas_x[fa->indices_arvejas[k]] != b->arvejas_x[fb->indices_arvejas[k]]) {
+                return 0;
+            }
+        }
+    }
+    return 1;
+}
 
 /**
- * Pruebas para strConcatenate.
- * El objetivo es validar la correcta unión de strings en casos
- * borde (vacíos, NULL) y la correcta gestión de la memoria,
- * verificando que los 'src' se liberen.
+ * Helper de los tests: carga oleadas desde un texto usando un archivo
+ * temporal, igual que si vinieran de disco.
  */
-void testStrConcatenate() {
-    printf("\n========= TESTS strConcatenate =========\n");
-    
-    // TEST 1: Pruebo string vacío + string
-    char* test1_s1 = strDuplicate("");
-    char* test1_s2 = strDuplicate("abc");
-    char* result1 = strConcatenate(test1_s1, test1_s2);
-    if (result1 != NULL && result1[0] == 'a' && result1[1] == 'b' && result1[2] == 'c' && result1[3] == '\0') {
-        printf("✓ TEST 1 PASADO: String vacio + 'abc' = 'abc'\n");
+static int cargarOleadasDeTexto(GameBoard* board, const char* texto) {
+    FILE* archivo = tmpfile();
+    if (archivo == NULL) {
+        return -1;
+    }
+    fputs(texto, archivo);
+    rewind(archivo);
+    int ok = cargarOleadas(board, archivo);
+    fclose(archivo);
+    return ok;
+}
+
+/**
+ * Pruebas para las colisiones por tiempo de impacto.
+ * La idea es validar que el tick calculado sea exactamente el primero en
+ * el que la arveja toca al zombie, que una arveja sin zombies adelante no
+ * quede en la cola hasta que spawnee uno, y que una partida en modo
+ * eventos evolucione igual que con el sort-and-sweep.
+ */
+void testModoEventos() {
+    printf("\n========= TESTS modo eventos =========\n");
+
+    GameBoard* board = gameBoardNew();
+    GameBoard* control = gameBoardNew();
+    if (board == NULL || control == NULL) {
+        printf("✗ Error al crear tablero para tests\n");
+        gameBoardDelete(board);
+        gameBoardDelete(control);
+        return;
+    }
+
+    // TEST 1: Pruebo el cálculo analítico contra la simulación tick a tick
+    int calculo_ok = 1;
+    for (int x = 100; x < 600; x += 7) {
+        SDL_Rect a = {x, 0, 20, 20};
+        SDL_Rect z = {0, 0, CELL_WIDTH, CELL_HEIGHT};
+        int zombie_x = INT_TO_FX(SCREEN_WIDTH) - x * 311;
+        z.x = FX_TO_INT(zombie_x);
+        if (arvejaTocaZombie(&a, &z)) continue;
+
+        int d = ticksHastaImpacto(a.x + a.w, zombie_x);
+        int pasos = 0;
+        while (!arvejaTocaZombie(&a, &z)) {
+            a.x += FX_TO_INT(PEA_SPEED_FX);
+            zombie_x -= ZOMBIE_SPEED_FX;
+            z.x = FX_TO_INT(zombie_x);
+            pasos++;
+        }
+        if (pasos != d) {
+            calculo_ok = 0;
+        }
+    }
+    if (calculo_ok) {
+        printf("✓ TEST 1 PASADO: El tick de impacto calculado es exacto\n");
     } else {
-        printf("✗ TEST 1 FALLADO: String vacio + 'abc' deberia ser 'abc'\n");
+        printf("✗ TEST 1 FALLADO: El tick de impacto no coincide con la simulacion\n");
     }
-    free(result1);
-    
-    // TEST 2: Pruebo string + string vacío
-    char* test2_s1 = strDuplicate("xyz");
-    char* test2_s2 = strDuplicate("");
-    char* result2 = strConcatenate(test2_s1, test2_s2);
-    if (result2 != NULL && result2[0] == 'x' && result2[1] == 'y' && result2[2] == 'z' && result2[3] == '\0') {
-        printf("✓ TEST 2 PASADO: 'xyz' + string vacio = 'xyz'\n");
+
+    // TEST 2: Pruebo que una arveja sin zombies adelante salga de la cola
+    // y vuelva a entrar cuando spawnea un zombie en su fila
+    gameBoardSetModoEventos(board, 1);
+    gameBoardAddZombie(board, 1);
+    Planta* p = createPlanta(1, 0);
+    if (p == NULL) {
+        gameBoardDelete(board);
+        gameBoardDelete(control);
+        return;
+    }
+    dispararArveja(board, p, 1);
+    free(p);
+    removeZombieNode(board, 1, board->rows[1].front_zombie); // Su blanco desaparece
+    gameBoardUpdate(board);
+    int sin_blanco = (board->cant_impactos == 0 && board->arvejas[0].pos_en_heap == -1);
+    gameBoardAddZombie(board, 1);
+    int programada = (board->cant_impactos == 1 && board->arvejas[0].pos_en_heap == 0);
+    gameBoardUpdate(board);
+    if (sin_blanco && programada && board->cant_impactos == board->cant_arvejas &&
+        board->arvejas[0].tick_impacto > board->tick) {
+        printf("✓ TEST 2 PASADO: Arveja sin blanco se programa al spawnear un zombie\n");
     } else {
-        printf("✗ TEST 2 FALLADO: 'xyz' + string vacio deberia ser 'xyz'\n");
+        printf("✗ TEST 2 FALLADO: La arveja sin blanco no se programo bien\n");
     }
-    free(result2);
-    
-    // TEST 3: Pruebo string de 1 char + 1 char
-    char* test3_s1 = strDuplicate("A");
-    char* test3_s2 = strDuplicate("B");
-    char* result3 = strConcatenate(test3_s1, test3_s2);
-    if (result3 != NULL && result3[0] == 'A' && result3[1] == 'B' && result3[2] == '\0') {
-        printf("✓ TEST 3 PASADO: 'A' + 'B' = 'AB'\n");
+    gameBoardDelete(board);
+
+    // TEST 3: Pruebo una partida completa contra el sort-and-sweep
+    board = gameBoardNew();
+    if (board == NULL) {
+        printf("✗ Error al recrear tablero\n");
+        gameBoardDelete(control);
+        return;
+    }
+    gameBoardSetModoEventos(board, 1);
+    // Misma semilla para los dos tableros: el cooldown inicial de las
+    // plantas y la fila de los zombies que spawnean salen de rand()
+    for (int c = 0; c < GRID_COLS; c += 2) {
+        srand(c);
+        gameBoardAddPlant(board, 2, c);
+        srand(c);
+        gameBoardAddPlant(control, 2, c);
+    }
+    int iguales = 1;
+    for (int t = 0; t < 3000 && iguales; t++) {
+        if (t % 400 == 0) {
+            gameBoardAddZombies(board, 2, 6, 30);
+            gameBoardAddZombies(control, 2, 6, 30);
+        }
+        srand(t);
+        gameBoardUpdate(board);
+        srand(t);
+        gameBoardUpdate(control);
+
+        ZombieNode* a = board->rows[2].first_zombie;
+        ZombieNode* b = control->rows[2].first_zombie;
+        while (a != NULL && b != NULL) {
+            if (a->zombie_data.pos_x != b->zombie_data.pos_x ||
+                a->zombie_data.vida != b->zombie_data.vida) {
+                iguales = 0;
+            }
+            a = a->next;
+            b = b->next;
+        }
+        if (a != NULL || b != NULL || board->cant_arvejas != control->cant_arvejas) {
+            iguales = 0;
+        }
+    }
+    if (iguales) {
+        printf("✓ TEST 3 PASADO: Modo eventos da lo mismo que el sort-and-sweep\n");
     } else {
-        printf("✗ TEST 3 FALLADO: 'A' + 'B' deberia ser 'AB'\n");
+        printf("✗ TEST 3 FALLADO: Modo eventos difiere del sort-and-sweep\n");
+    }
+    gameBoardDelete(board);
+    gameBoardDelete(control);
+
+    // TEST 4: Pruebo un zombie que spawnea ADELANTE del blanco de una
+    // arveja (el que le quedaba era el final de una oleada, todavía fuera
+    // de pantalla): la arveja le tiene que pegar al nuevo
+    board = gameBoardNew();
+    control = gameBoardNew();
+    Planta* q = createPlanta(0, 0);
+    if (board == NULL || control == NULL || q == NULL) {
+        printf("✗ Error al recrear tablero\n");
+        gameBoardDelete(board);
+        gameBoardDelete(control);
+        free(q);
+        srand(time(NULL));
+        return;
     }
-    free(result3);
-    
-    // TEST 4: Pruebo dos strings normales
-    char* test4_s1 = strDuplicate("Hola ");
-    char* test4_s2 = strDuplicate("Mundo");
-    char* result4 = strConcatenate(test4_s1, test4_s2);
-    int test4_ok = 1;
-    char* expected4 = "Hola Mundo";
-    if (result4 == NULL) {
-        test4_ok = 0;
+    gameBoardSetModoEventos(board, 1);
+    GameBoard* tableros[2] = {board, control};
+    for (int b = 0; b < 2; b++) {
+        gameBoardAddZombies(tableros[b], 0, 2, 200);
+        removeZombieNode(tableros[b], 0, tableros[b]->rows[0].front_zombie);
+        dispararArveja(tableros[b], q, 0);
+        gameBoardUpdate(tableros[b]);
+        gameBoardAddZombie(tableros[b], 0);
+    }
+    free(q);
+    iguales = 1;
+    for (int t = 0; t < 250 && iguales; t++) {
+        gameBoardUpdate(board);
+        gameBoardUpdate(control);
+        iguales = mismoEstado(board, control);
+    }
+    if (iguales && board->rows[0].front_zombie->zombie_data.vida < 100) {
+        printf("✓ TEST 4 PASADO: La arveja le pega al zombie que spawneo adelante de su blanco\n");
     } else {
-        // Verifico contenido
-        int i = 0;
-        while (expected4[i] != '\0') {
-            if (result4[i] != expected4[i]) {
-                test4_ok = 0;
-                break;
+        printf("✗ TEST 4 FALLADO: La arveja atraveso al zombie nuevo (tick %d)\n", board->tick);
+    }
+    gameBoardDelete(board);
+    gameBoardDelete(control);
+
+    // TEST 5: Pruebo oleadas y zombies sueltos al azar (a veces adelante
+    // de los que ya estaban) contra el sort-and-sweep, con varias semillas
+    iguales = 1;
+    for (int semilla = 0; semilla < 8 && iguales; semilla++) {
+        board = gameBoardNew();
+        control = gameBoardNew();
+        if (board == NULL || control == NULL) {
+            gameBoardDelete(board);
+            gameBoardDelete(control);
+            iguales = 0;
+            break;
+        }
+        gameBoardSetModoEventos(board, 1);
+        for (int r = 0; r < GRID_ROWS; r++) {
+            for (int c = (semilla + r) % 3; c < GRID_COLS; c += 3) {
+                srand(semilla * GRID_ROWS + r + c);
+                gameBoardAddPlant(board, r, c);
+                srand(semilla * GRID_ROWS + r + c);
+                gameBoardAddPlant(control, r, c);
             }
-            i++;
         }
-        if (result4[i] != '\0') {
-            test4_ok = 0;
+        for (int t = 0; t < 6000 && iguales; t++) {
+            srand(semilla * 100003 + t);
+            int accion = rand() % 40;
+            int row = rand() % GRID_ROWS;
+            int cantidad = 1 + rand() % 8;
+            int espaciado = rand() % 120;
+            if (accion == 0) {
+                gameBoardAddZombies(board, row, cantidad, espaciado);
+                gameBoardAddZombies(control, row, cantidad, espaciado);
+            } else if (accion == 1) {
+                gameBoardAddZombie(board, row);
+                gameBoardAddZombie(control, row);
+            }
+            srand(t);
+            gameBoardUpdate(board);
+            srand(t);
+            gameBoardUpdate(control);
+            iguales = mismoEstado(board, control);
         }
+        gameBoardDelete(board);
+        gameBoardDelete(control);
     }
-    if (test4_ok) {
-        printf("✓ TEST 4 PASADO: 'Hola ' + 'Mundo' = 'Hola Mundo'\n");
+    if (iguales) {
+        printf("✓ TEST 5 PASADO: Spawns al azar dan lo mismo en los dos modos\n");
     } else {
-        printf("✗ TEST 4 FALLADO: 'Hola ' + 'Mundo' deberia ser 'Hola Mundo'\n");
+        printf("✗ TEST 5 FALLADO: Con spawns al azar el modo eventos difiere\n");
     }
-    free(result4);
-    
-    // TEST 5: Prueba conceptual de la gestión de memoria.
-    // Al usar strDuplicate, me aseguro que los 'src' están en el heap.
-    // Si strConcatenate los libera (como pide la consigna) y puedo
-    // liberar el 'resultado' sin crasheos, la memoria se manejó bien.
-    char* test5_s1 = strDuplicate("Test");
-    char* test5_s2 = strDuplicate("123");
-    char* result5 = strConcatenate(test5_s1, test5_s2);
-    if (result5 != NULL) {
-        printf("✓ TEST 5 PASADO: Concatenacion exitosa (memoria liberada internamente)\n");
+    srand(time(NULL));
+
+    printf("========================================\n");
+    printf("Tests completados para modo eventos\n");
+    printf("========================================\n\n");
+}
+
+
+
+// ========== TESTS ZOMBIES ACTIVOS ==========
+
+
+/**
+ * Pruebas para el contador de zombies activos por fila.
+ * La idea es validar que el contador acompañe a la lista (spawn, oleadas
+ * y muertes) y que una planta en una fila vacía no gaste arvejas.
+ */
+void testZombiesActivos() {
+    printf("\n========= TESTS zombies activos =========\n");
+
+    GameBoard* board = gameBoardNew();
+    if (board == NULL) {
+        printf("✗ Error al crear tablero para tests\n");
+        return;
+    }
+
+    // TEST 1: Pruebo el contador al agregar y sacar zombies
+    gameBoardAddZombie(board, 0);
+    gameBoardAddZombies(board, 0, 5, 10);
+    gameBoardAddZombies(board, 3, 2, 0);
+    int agregados_ok = (board->rows[0].zombies_activos == 6 &&
+                        board->rows[3].zombies_activos == 2 &&
+                        board->rows[1].zombies_activos == 0);
+    removeZombieNode(board, 0, board->rows[0].front_zombie);
+    removeZombieNode(board, 0, board->rows[0].first_zombie);
+    removeZombieNode(board, 3, board->rows[3].first_zombie);
+    if (agregados_ok && board->rows[0].zombies_activos == 4 &&
+        board->rows[3].zombies_activos == 1) {
+        printf("✓ TEST 1 PASADO: El contador sigue a los zombies de la fila\n");
     } else {
-        printf("✗ TEST 5 FALLADO: Error en concatenacion\n");
+        printf("✗ TEST 1 FALLADO: Contador de zombies incorrecto\n");
     }
-    free(result5);
-    
-    printf("========================================\n\n");
 
-    // TEST 6: Pruebo la robustez ante un NULL
-    char* test6_s1 = strDuplicate("Hola");
-    char* test6_s2 = NULL;
-    char* result6 = strConcatenate(test6_s1, test6_s2);
-    if (result6 != NULL && result6[0] == 'H' && result6[4] == '\0') {
-        printf("✓ TEST 6 PASADO: 'Hola' + NULL = 'Hola'\n");
+    // TEST 2: Pruebo que la planta de una fila sin zombies no dispare,
+    // y la de una fila con zombies sí (antes de que spawnee ninguno nuevo)
+    gameBoardAddPlant(board, 1, 0);
+    gameBoardAddPlant(board, 3, 0);
+    for (int t = 0; t < ZOMBIE_SPAWN_RATE - 1; t++) {
+        gameBoardUpdate(board);
+    }
+    if (board->rows[1].cant_arvejas == 0 && board->rows[3].cant_arvejas > 0) {
+        printf("✓ TEST 2 PASADO: Solo disparan las plantas con zombies en la fila\n");
     } else {
-        printf("✗ TEST 6 FALLADO: 'Hola' + NULL deberia ser 'Hola'\n");
+        printf("✗ TEST 2 FALLADO: Arvejas en fila vacia %d, en fila con zombies %d\n",
+               board->rows[1].cant_arvejas, board->rows[3].cant_arvejas);
     }
-    free(result6);
+
+    gameBoardDelete(board);
+    printf("========================================\n");
+    printf("Tests completados para zombies activos\n");
+    printf("========================================\n\n");
 }
 
 
 
-// ========== TESTS gameBoardAddPlant ==========
+// ========== TESTS gameBoardNearestZombieAhead ==========
 
 
 /**
- * Pruebas para gameBoardAddPlant.
- * La idea es validar exhaustivamente la lógica de "división de segmentos",
- * que es el núcleo de la gestión de la grilla.
+ * Pruebas para el índice ordenado de zombies y las plantas con alcance.
+ * La idea es validar que el índice quede en el mismo orden que la lista
+ * (al revés) después de oleadas y muertes, que la búsqueda binaria dé
+ * lo mismo que recorrer la lista, y que una planta con alcance espere a
+ * que el zombie entre en rango para disparar.
  */
-void testGameBoardAddPlant() {
-    printf("\n========= TESTS gameBoardAddPlant =========\n");
-    
+void testGameBoardNearestZombieAhead() {
+    printf("\n========= TESTS gameBoardNearestZombieAhead =========\n");
+
     GameBoard* board = gameBoardNew();
     if (board == NULL) {
         printf("✗ Error al crear tablero para tests\n");
         return;
     }
-    
-    // TEST 0: Pruebo la robustez ante inputs inválidos.
-    // La función no debería crashear ni agregar nada.
-    if (gameBoardAddPlant(NULL, 0, 0) == 0 &&
-        gameBoardAddPlant(board, -1, 0) == 0 &&
-        gameBoardAddPlant(board, GRID_ROWS, 0) == 0 &&
-        gameBoardAddPlant(board, 0, -1) == 0 &&
-        gameBoardAddPlant(board, 0, GRID_COLS) == 0) {
-        printf("✓ TEST 0 PASADO: Maneja inputs invalidos correctamente\n");
+
+    // TEST 0: Pruebo la robustez ante parámetros inválidos
+    if (gameBoardNearestZombieAhead(NULL, 0, 0) == NULL &&
+        gameBoardNearestZombieAhead(board, GRID_ROWS, 0) == NULL &&
+        gameBoardNearestZombieAhead(board, 0, 0) == NULL &&
+        gameBoardSetPlantRange(board, 0, 0, 100) == 0) {
+        printf("✓ TEST 0 PASADO: Parametros invalidos y fila vacia\n");
     } else {
-        printf("✗ TEST 0 FALLADO: No maneja inputs invalidos\n");
+        printf("✗ TEST 0 FALLADO: Error con parametros invalidos\n");
     }
-    
-    // TEST 1: Pruebo agregar en el medio (Consigna 1)
-    // Valida la lógica de división en 3 segmentos: VACIO-PLANTA-VACIO.
-    if (gameBoardAddPlant(board, 0, 4) == 1) {
-        RowSegment* seg = board->rows[0].first_segment;
-        // Reviso la estructura de la lista: [VACIO, 0, 4] -> [PLANTA, 4, 1] -> [VACIO, 5, 4]
-        if (seg != NULL && seg->status == STATUS_VACIO && seg->start_col == 0 && seg->length == 4 &&
-            seg->next != NULL && seg->next->status == STATUS_PLANTA && seg->next->start_col == 4 && seg->next->length == 1 &&
-            seg->next->next != NULL && seg->next->next->status == STATUS_VACIO && seg->next->next->start_col == 5 && seg->next->next->length == 4 &&
-            seg->next->next->next == NULL) {
-            printf("✓ TEST 1 PASADO: Agregar en medio de fila vacia\n");
-        } else {
-            printf("✗ TEST 1 FALLADO: Estructura incorrecta despues de agregar en medio\n");
+
+    // TEST 1: Pruebo que el índice siga a la lista con oleadas, zombies
+    // sueltos y muertes (adelante, atrás y en el medio)
+    GardenRow* fila = &board->rows[4];
+    for (int i = 0; i < 30; i++) {
+        gameBoardAddZombies(board, 4, 3, 25);
+        for (int t = 0; t < 40; t++) {
+            ZombieNode* z_node = fila->first_zombie;
+            while (z_node != NULL) {
+                z_node->zombie_data.pos_x -= INT_TO_FX(1);
+                z_node->zombie_data.rect.x = FX_TO_INT(z_node->zombie_data.pos_x);
+                z_node = z_node->next;
+            }
         }
-    } else {
-        printf("✗ TEST 1 FALLADO: No se pudo agregar en medio\n");
+        gameBoardAddZombie(board, 4);
+        if (i % 3 == 0) removeZombieNode(board, 4, fila->front_zombie);
+        if (i % 4 == 1) removeZombieNode(board, 4, fila->first_zombie);
+        if (i % 5 == 2) removeZombieNode(board, 4, fila->first_zombie->next);
     }
-    
-    // TEST 2: Pruebo agregar al inicio (Consigna 1)
-    // Valida la lógica de división en 2 segmentos al inicio: PLANTA-VACIO.
-    resetRow(&board->rows[0]);
-    if (gameBoardAddPlant(board, 0, 0) == 1) {
-        RowSegment* seg = board->rows[0].first_segment;
-        // Reviso la estructura: [PLANTA, 0, 1] -> [VACIO, 1, 8]
-        if (seg != NULL && seg->status == STATUS_PLANTA && seg->start_col == 0 && seg->length == 1 &&
-            seg->next != NULL && seg->next->status == STATUS_VACIO && seg->next->start_col == 1 && seg->next->length == 8 &&
-            seg->next->next == NULL) {
-            printf("✓ TEST 2 PASADO: Agregar al inicio de fila vacia\n");
-        } else {
-            printf("✗ TEST 2 FALLADO: Estructura incorrecta despues de agregar al inicio\n");
+    int indice_ok = 1;
+    int k = fila->inicio_zombies + fila->zombies_activos - 1;
+    for (ZombieNode* z_node = fila->first_zombie; z_node != NULL; z_node = z_node->next, k--) {
+        if (k < fila->inicio_zombies || fila->zombies_por_x[k] != z_node || z_node->pos_en_fila != k) {
+            indice_ok = 0;
         }
+    }
+    if (indice_ok && k == fila->inicio_zombies - 1) {
+        printf("✓ TEST 1 PASADO: El indice ordenado coincide con la lista\n");
     } else {
-        printf("✗ TEST 2 FALLADO: No se pudo agregar al inicio\n");
+        printf("✗ TEST 1 FALLADO: El indice ordenado no coincide con la lista\n");
     }
-    
-    // TEST 3: Pruebo agregar al final (Consigna 1)
-    // Valida la lógica de división en 2 segmentos al final: VACIO-PLANTA.
-    resetRow(&board->rows[0]);
-    if (gameBoardAddPlant(board, 0, 8) == 1) {
-        RowSegment* seg = board->rows[0].first_segment;
-        // Reviso la estructura: [VACIO, 0, 8] -> [PLANTA, 8, 1]
-        if (seg != NULL && seg->status == STATUS_VACIO && seg->start_col == 0 && seg->length == 8 &&
-            seg->next != NULL && seg->next->status == STATUS_PLANTA && seg->next->start_col == 8 && seg->next->length == 1 &&
-            seg->next->next == NULL) {
-            printf("✓ TEST 3 PASADO: Agregar al final de fila vacia\n");
-        } else {
-            printf("✗ TEST 3 FALLADO: Estructura incorrecta despues de agregar al final\n");
+
+    // TEST 2: Pruebo la búsqueda binaria contra recorrer la lista
+    int busqueda_ok = 1;
+    for (int x = -100; x < SCREEN_WIDTH + 1300; x += 13) {
+        ZombieNode* esperado = fila->front_zombie;
+        while (esperado != NULL &&
+               esperado->zombie_data.rect.x + esperado->zombie_data.rect.w <= x) {
+            esperado = esperado->prev;
+        }
+        if (gameBoardNearestZombieAhead(board, 4, x) != esperado) {
+            busqueda_ok = 0;
         }
-    } else {
-        printf("✗ TEST 3 FALLADO: No se pudo agregar al final\n");
     }
-    
-    // TEST 4: Pruebo celda ocupada (Consigna 3)
-    // La función debe retornar 0 (fallo) si se planta sobre una PLANTA existente.
-    resetRow(&board->rows[0]);
-    gameBoardAddPlant(board, 0, 4); // Planto la primera vez
-    if (gameBoardAddPlant(board, 0, 4) == 0) { // Intento plantar de nuevo
-        printf("✓ TEST 4 PASADO: No permite agregar en celda ocupada\n");
+    if (busqueda_ok) {
+        printf("✓ TEST 2 PASADO: La busqueda coincide con recorrer la lista\n");
     } else {
-        printf("✗ TEST 4 FALLADO: Permitio agregar en celda ocupada\n");
+        printf("✗ TEST 2 FALLADO: La busqueda no coincide con recorrer la lista\n");
     }
-    
-    // TEST 5: Pruebo llenar la fila (Consigna 2)
-    // Valida que la lista de segmentos maneje el caso de 9 nodos PLANTA seguidos.
-    resetRow(&board->rows[1]);
-    int added_all = 1;
-    for (int c = 0; c < GRID_COLS; c++) {
-        if (gameBoardAddPlant(board, 1, c) != 1) {
-            added_all = 0;
-            break;
-        }
+    gameBoardDelete(board);
+
+    // TEST 3: Pruebo que una planta con alcance no dispare hasta que el
+    // zombie entra en rango, y que una común dispare desde el principio
+    board = gameBoardNew();
+    if (board == NULL) {
+        printf("✗ Error al recrear tablero\n");
+        return;
     }
-    if (added_all) {
-        RowSegment* seg = board->rows[1].first_segment;
-        int count = 0;
-        int all_plants = 1;
-        while (seg != NULL) {
-            if (seg->status != STATUS_PLANTA || seg->length != 1) {
-                all_plants = 0;
-                break;
-            }
-            count++;
-            seg = seg->next;
+    gameBoardAddPlant(board, 0, 0);
+    gameBoardAddPlant(board, 1, 0);
+    gameBoardAddZombie(board, 0);
+    gameBoardAddZombie(board, 1);
+    int alcance = 3 * CELL_WIDTH;
+    int seteado = gameBoardSetPlantRange(board, 0, 0, alcance);
+    int boca = GRID_OFFSET_X + (CELL_WIDTH / 2);
+    int fuera_de_rango_ok = 1;
+    int esperas_largas = 0; // Ticks en los que la planta esperaba más de un tick en la rueda
+    Planta* con_alcance = board->rows[0].first_segment->planta_data;
+    int comun_disparo = 0;
+    for (int t = 0; t < ZOMBIE_SPAWN_RATE - 1; t++) {
+        gameBoardUpdate(board);
+        ZombieNode* z_node = board->rows[0].front_zombie;
+        if (z_node != NULL && z_node->zombie_data.rect.x - boca > alcance &&
+            board->rows[0].cant_arvejas > 0) {
+            fuera_de_rango_ok = 0;
         }
-        if (all_plants && count == GRID_COLS) {
-            printf("✓ TEST 5 PASADO: Llenar fila completa (9 plantas)\n");
-        } else {
-            printf("✗ TEST 5 FALLADO: Estructura incorrecta (encontradas %d plantas)\n", count);
+        if (con_alcance->esperando_rango && con_alcance->tick_rueda > board->tick + 1) {
+            esperas_largas++;
+        }
+        if (board->rows[1].cant_arvejas > 0) {
+            comun_disparo = 1;
         }
-    } else {
-        printf("✗ TEST 5 FALLADO: No se pudo llenar la fila completa\n");
     }
-    
-    // TEST 6: Prueba avanzada de llenado de huecos.
-    // Simula un patrón de plantado no lineal (pares, luego impares).
-    resetRow(&board->rows[2]);
-    int pattern_ok = 1;
-    for (int c = 0; c < GRID_COLS; c += 2) { // Columnas pares
-        if (gameBoardAddPlant(board, 2, c) != 1) pattern_ok = 0;
+    int sin_disparar = board->rows[0].cant_arvejas;
+    // Dejo que el zombie camine hasta entrar en rango: tiene que disparar
+    // a más tardar un ciclo de animación después
+    int entro = -1;
+    for (int t = 0; t < 4000 && board->rows[0].cant_arvejas == 0; t++) {
+        gameBoardUpdate(board);
+        ZombieNode* z_node = board->rows[0].front_zombie;
+        if (z_node->zombie_data.rect.x - boca > alcance) {
+            if (board->rows[0].cant_arvejas > 0) fuera_de_rango_ok = 0;
+        } else if (entro < 0) {
+            entro = board->tick;
+        }
     }
-    for (int c = 1; c < GRID_COLS; c += 2) { // Columnas impares (huecos)
-        if (gameBoardAddPlant(board, 2, c) != 1) pattern_ok = 0;
+    if (entro < 0 || board->tick - entro > PEASHOOTER_TOTAL_FRAMES * PEASHOOTER_ANIMATION_SPEED) {
+        fuera_de_rango_ok = 0;
     }
-    
-    if (pattern_ok) {
-        // Al final, la fila debe estar llena (9 segmentos PLANTA)
-        RowSegment* seg = board->rows[2].first_segment;
-        int plant_count = 0;
-        while (seg != NULL) {
-            if (seg->status == STATUS_PLANTA) plant_count++;
-            seg = seg->next;
-        }
-        if (plant_count == GRID_COLS) {
-            printf("✓ TEST 6 PASADO: Patron alternado y llenado de huecos\n");
-        } else {
-            printf("✗ TEST 6 FALLADO: Esperaba %d plantas, encontre %d\n", GRID_COLS, plant_count);
-        }
+    if (seteado && fuera_de_rango_ok && sin_disparar == 0 && esperas_largas > 0 &&
+        board->rows[0].cant_arvejas > 0 && comun_disparo) {
+        printf("✓ TEST 3 PASADO: La planta con alcance espera al zombie\n");
     } else {
-        printf("✗ TEST 6 FALLADO: No se pudo crear patron alternado\n");
+        printf("✗ TEST 3 FALLADO: La planta con alcance disparo fuera de rango\n");
     }
-    
-    // TEST 7: Prueba avanzada de caso borde: plantar en un hueco (length=1) al inicio.
-    resetRow(&board->rows[3]);
-    gameBoardAddPlant(board, 3, 1); // Deja hueco en col 0
-    if (gameBoardAddPlant(board, 3, 0) == 1) { // Llena el hueco
-        RowSegment* seg = board->rows[3].first_segment;
-        // Valida que los dos primeros segmentos sean PLANTA
-        if (seg != NULL && seg->status == STATUS_PLANTA && seg->start_col == 0 &&
-            seg->next != NULL && seg->next->status == STATUS_PLANTA && seg->next->start_col == 1) {
-            printf("✓ TEST 7 PASADO: Agregar en segmento length=1 al inicio\n");
-        } else {
-            printf("✗ TEST 7 FALLADO: Estructura incorrecta en segmento length=1\n");
-        }
+    gameBoardDelete(board);
+
+    // TEST 4: Pruebo que una planta con alcance que quedó esperando sin
+    // zombies adelante (uno ya la pasó) dispare si le saco el alcance.
+    // Sin spawn aleatorio: solo está el zombie que agrego
+    board = gameBoardNew();
+    if (board == NULL) {
+        printf("✗ Error al recrear tablero\n");
+        return;
+    }
+    cargarOleadasDeTexto(board, "");
+    gameBoardAddZombie(board, 0);
+    int boca_ultima = GRID_OFFSET_X + (GRID_COLS - 1) * CELL_WIDTH + (CELL_WIDTH / 2);
+    while (board->rows[0].front_zombie->zombie_data.rect.x + CELL_WIDTH > boca_ultima) {
+        gameBoardUpdate(board);
+    }
+    gameBoardAddPlant(board, 0, GRID_COLS - 1);
+    gameBoardSetPlantRange(board, 0, GRID_COLS - 1, CELL_WIDTH);
+    Planta* pasada = NULL;
+    for (RowSegment* seg = board->rows[0].first_segment; seg != NULL; seg = seg->next) {
+        if (seg->planta_data != NULL) pasada = seg->planta_data;
+    }
+    for (int t = 0; t < 150; t++) {
+        gameBoardUpdate(board);
+    }
+    int estacionada = (pasada != NULL && pasada->tick_rueda == -1 &&
+                       board->rows[0].zombies_activos == 1 && board->cant_arvejas == 0);
+    gameBoardSetPlantRange(board, 0, GRID_COLS - 1, 0);
+    for (int t = 0; t < PEASHOOTER_TOTAL_FRAMES * PEASHOOTER_ANIMATION_SPEED + 1 &&
+                    board->cant_arvejas == 0; t++) {
+        gameBoardUpdate(board);
+    }
+    if (estacionada && board->cant_arvejas > 0) {
+        printf("✓ TEST 4 PASADO: Sin alcance la planta esperando vuelve a disparar\n");
     } else {
-        printf("✗ TEST 7 FALLADO: No se pudo agregar en segmento length=1\n");
+        printf("✗ TEST 4 FALLADO: La planta esperando no disparo al sacarle el alcance\n");
     }
-    
-    // TEST 8: Prueba avanzada de caso borde: plantar en un hueco (length=1) al final.
-    resetRow(&board->rows[3]);
-    gameBoardAddPlant(board, 3, 7); // Deja hueco en col 8
-    if (gameBoardAddPlant(board, 3, 8) == 1) { // Llena el hueco
-        RowSegment* seg = board->rows[3].first_segment;
-        while (seg != NULL && seg->next != NULL && seg->next->next != NULL) {
-            seg = seg->next; // Avanzo hasta el anteúltimo segmento
-        }
-        // Valida que los dos últimos segmentos sean PLANTA
-        if (seg != NULL && seg->status == STATUS_PLANTA && seg->start_col == 7 &&
-            seg->next != NULL && seg->next->status == STATUS_PLANTA && seg->next->start_col == 8) {
-            printf("✓ TEST 8 PASADO: Agregar en segmento length=1 al final\n");
-        } else {
-            printf("✗ TEST 8 FALLADO: Estructura incorrecta en segmento length=1 al final\n");
-        }
+
+    gameBoardDelete(board);
+    printf("========================================\n");
+    printf("Tests completados para gameBoardNearestZombieAhead\n");
+    printf("========================================\n\n");
+}
+
+
+
+// ========== TESTS gameBoardGetHits ==========
+
+
+/**
+ * Pruebas para el buffer de golpes.
+ * La idea es validar que, con varias arvejas pegándole al mismo zombie
+ * en un tick, la detección reparta los golpes como si el daño se aplicara
+ * en el momento (las que sobran le pegan al de atrás), y que el resultado
+ * sea el mismo en modo eventos.
+ */
+void testGameBoardGetHits() {
+    printf("\n========= TESTS gameBoardGetHits =========\n");
+
+    int cantidad = -1;
+    if (gameBoardGetHits(NULL, &cantidad) == NULL && cantidad == -1) {
+        printf("✓ TEST 0 PASADO: NULL devuelve NULL\n");
     } else {
-        printf("✗ TEST 8 FALLADO: No se pudo agregar en segmento length=1 al final\n");
+        printf("✗ TEST 0 FALLADO: NULL no devolvio NULL\n");
     }
-    
-    // TEST 9: Prueba de robustez: verifica que planta_data (memoria anidada)
-    // se haya asignado e inicializado correctamente.
-    resetRow(&board->rows[4]);
-    if (gameBoardAddPlant(board, 4, 3) == 1) {
-        RowSegment* seg = board->rows[4].first_segment;
-        while (seg != NULL && seg->status != STATUS_PLANTA) {
-            seg = seg->next; // Busco el segmento planta
+
+    Planta* p = createPlanta(0, 0);
+    if (p == NULL) {
+        return;
+    }
+    for (int modo = 0; modo <= 1; modo++) {
+        GameBoard* board = gameBoardNew();
+        if (board == NULL) {
+            printf("✗ Error al crear tablero para tests\n");
+            free(p);
+            return;
         }
-        if (seg != NULL && seg->planta_data != NULL) {
-            // Verifico que los datos de la planta sean correctos
-            if (seg->planta_data->activo == 1 &&
-                seg->planta_data->rect.x == GRID_OFFSET_X + (3 * CELL_WIDTH) &&
-                seg->planta_data->rect.y == GRID_OFFSET_Y + (4 * CELL_HEIGHT)) {
-                printf("✓ TEST 9 PASADO: planta_data inicializada correctamente\n");
-            } else {
-                printf("✗ TEST 9 FALLADO: planta_data mal inicializada\n");
+        gameBoardSetModoEventos(board, modo);
+
+        // Dos zombies casi encimados y cinco arvejas que ya los tocan:
+        // cuatro matan al de adelante y la quinta le pega al de atrás
+        gameBoardAddZombies(board, 0, 2, 2);
+        ZombieNode* atras = board->rows[0].first_zombie;
+        ZombieNode* adelante = board->rows[0].front_zombie;
+        adelante->zombie_data.pos_x = INT_TO_FX(500);
+        atras->zombie_data.pos_x = INT_TO_FX(502);
+        ZombieHandle h_adelante = gameBoardGetZombieHandle(adelante);
+        ZombieHandle h_atras = gameBoardGetZombieHandle(atras);
+        for (int i = 0; i < 5; i++) {
+            dispararArveja(board, p, 0);
+            board->arvejas_x[i] = INT_TO_FX(480);
+        }
+        gameBoardUpdate(board);
+
+        const Golpe* golpes = gameBoardGetHits(board, &cantidad);
+        int golpes_ok = (cantidad == 5);
+        for (int g = 0; g < cantidad && golpes_ok; g++) {
+            ZombieHandle esperado = g < 4 ? h_adelante : h_atras;
+            if (golpes[g].zombie.index != esperado.index || golpes[g].dano != PEA_DAMAGE ||
+                golpes[g].fila != 0) {
+                golpes_ok = 0;
             }
+        }
+        ZombieNode* sobreviviente = gameBoardGetZombie(board, h_atras);
+        if (golpes_ok && gameBoardGetZombie(board, h_adelante) == NULL &&
+            sobreviviente != NULL && sobreviviente->zombie_data.vida == 100 - PEA_DAMAGE &&
+            board->cant_arvejas == 0 && board->rows[0].cant_arvejas == 0) {
+            printf("✓ TEST %d PASADO: Golpes detectados y aplicados (%s)\n",
+                   modo + 1, modo ? "modo eventos" : "sort-and-sweep");
         } else {
-            printf("✗ TEST 9 FALLADO: planta_data es NULL\n");
+            printf("✗ TEST %d FALLADO: Golpes incorrectos (%s), cantidad %d\n",
+                   modo + 1, modo ? "modo eventos" : "sort-and-sweep", cantidad);
         }
-    } else {
-        printf("✗ TEST 9 FALLADO: No se pudo agregar planta\n");
+        gameBoardDelete(board);
     }
-    
-    // Libero toda la memoria usada en los tests
-    gameBoardDelete(board);
+    free(p);
+
     printf("========================================\n");
-    printf("Tests completados para gameBoardAddPlant\n");
+    printf("Tests completados para gameBoardGetHits\n");
     printf("========================================\n\n");
 }
 
 
 
-
-
-// ========== TESTS gameBoardRemovePlant ==========
+// ========== TESTS RUEDA DE PLANTAS ==========
 
 
 /**
- * Pruebas para gameBoardRemovePlant.
- * La idea es validar la lógica de "fusión de segmentos",
- * que es el problema central de esta función. Los tests
- * cubren los casos mínimos de la consigna y varios
- * casos borde (fusión al inicio, al final y triple).
+ * Pruebas para la rueda de tiempos de las plantas.
+ * La idea es validar que una planta sin zombies en su fila deje la rueda
+ * hasta que spawnee uno, que después de disparar vuelva a la rueda para
+ * cuando termina el cooldown, y que al sacarla no quede en ninguna lista.
  */
-void testGameBoardRemovePlant() {
-    printf("\n========= TESTS gameBoardRemovePlant =========\n");
+void testRuedaDePlantas() {
+    printf("\n========= TESTS rueda de plantas =========\n");
 
     GameBoard* board = gameBoardNew();
     if (board == NULL) {
@@ -1501,405 +5171,635 @@ void testGameBoardRemovePlant() {
         return;
     }
 
-    // TEST 0: Pruebo la robustez ante inputs inválidos.
-    gameBoardRemovePlant(NULL, 0, 0);
-    gameBoardRemovePlant(board, -1, 0);
-    gameBoardRemovePlant(board, GRID_ROWS, 0);
-    gameBoardRemovePlant(board, 0, -1);
-    gameBoardRemovePlant(board, 0, GRID_COLS);
-    printf("✓ TEST 0 PASADO: Maneja inputs invalidos sin crash\n");
-
-    // TEST 1: Pruebo remover de una celda ya vacía.
-    // La lista de segmentos debe quedar intacta (1 solo nodo VACIO).
-    resetRow(&board->rows[0]);
-    gameBoardRemovePlant(board, 0, 4);
-    RowSegment* seg = board->rows[0].first_segment;
-    if (seg != NULL && seg->status == STATUS_VACIO && seg->start_col == 0 && 
-        seg->length == GRID_COLS && seg->next == NULL) {
-        printf("✓ TEST 1 PASADO: Remover en celda vacia no cambia nada\n");
+    // TEST 1: Pruebo que sin zombies la planta quede esperando en su fila
+    gameBoardAddPlant(board, 0, 3);
+    Planta* p = board->rows[0].first_segment->next->planta_data;
+    for (int t = 0; t < 150; t++) {
+        gameBoardUpdate(board);
+    }
+    if (p->tick_rueda == -1 && board->rows[0].plantas_esperando == p &&
+        board->cant_arvejas == 0) {
+        printf("✓ TEST 1 PASADO: Sin zombies la planta sale de la rueda\n");
     } else {
-        printf("✗ TEST 1 FALLADO: Modifico estructura sin planta\n");
+        printf("✗ TEST 1 FALLADO: La planta no quedo esperando zombies\n");
     }
 
-    // TEST 2: Pruebo la Consigna 1 (Plantar 3, 4, 5 y sacar 4).
-    // Esto prueba que al sacar la planta del medio, se crea un hueco (VACIO, length=1)
-    // que NO se fusiona con sus vecinos (PLANTA).
-    resetRow(&board->rows[0]);
-    gameBoardAddPlant(board, 0, 3);
-    gameBoardAddPlant(board, 0, 4);
-    gameBoardAddPlant(board, 0, 5);
-    gameBoardRemovePlant(board, 0, 4);
-    
-    // Verifico el estado: PLANTA en 3, VACIO en 4, PLANTA en 5.
-    seg = board->rows[0].first_segment;
-    int found_plant_3 = 0, found_vacio_4 = 0, found_plant_5 = 0;
-    while (seg != NULL) {
-        if (seg->status == STATUS_PLANTA && seg->start_col == 3) found_plant_3 = 1;
-        if (seg->status == STATUS_VACIO && seg->start_col == 4 && seg->length == 1) found_vacio_4 = 1;
-        if (seg->status == STATUS_PLANTA && seg->start_col == 5) found_plant_5 = 1;
-        seg = seg->next;
+    // TEST 2: Pruebo que al spawnear un zombie vuelva a la rueda y dispare
+    gameBoardAddZombie(board, 0);
+    int despierta = (board->rows[0].plantas_esperando == NULL &&
+                     p->tick_rueda == board->tick + 1);
+    int ticks = 0;
+    while (board->cant_arvejas == 0 && ticks < PEASHOOTER_TOTAL_FRAMES * PEASHOOTER_ANIMATION_SPEED) {
+        gameBoardUpdate(board);
+        ticks++;
     }
-    
-    if (found_plant_3 && found_vacio_4 && found_plant_5) {
-        printf("✓ TEST 2 PASADO: Sacar planta del medio (no fusiona con plantas adyacentes)\n");
+    if (despierta && board->cant_arvejas == 1 && framePlanta(board, p) == PEASHOOTER_SHOOT_FRAME &&
+        p->tick_rueda == board->tick + PEASHOOTER_COOLDOWN + 1) {
+        printf("✓ TEST 2 PASADO: Dispara en su frame y espera el cooldown\n");
     } else {
-        printf("✗ TEST 2 FALLADO: Estructura incorrecta al sacar planta del medio\n");
+        printf("✗ TEST 2 FALLADO: Disparo o reprogramacion incorrectos\n");
     }
 
-    // TEST 3: Pruebo la Consigna 2 (Seguir del caso anterior y sacar 3).
-    // Estado actual: [VACIO 0-2] [PLANTA 3] [VACIO 4] [PLANTA 5] [VACIO 6-8]
-    // Al sacar 3, [VACIO 3] debe fusionarse con [VACIO 4] y con [VACIO 0-2].
-    // El resultado debe ser un gran segmento [VACIO 0-4].
+    // TEST 3: Pruebo que al sacar la planta deje la rueda
+    Planta** slot = &board->rueda_plantas[p->tick_rueda & (RUEDA_PLANTAS - 1)];
     gameBoardRemovePlant(board, 0, 3);
-    
-    seg = board->rows[0].first_segment;
-    int found_fused_vacio = 0;
-    int still_has_plant_5 = 0;
-    while (seg != NULL) {
-        // Busco un segmento VACIO que cubra el rango [0-4]
-        if (seg->status == STATUS_VACIO && seg->start_col == 0 && seg->length == 5) {
-            found_fused_vacio = 1;
-        }
-        if (seg->status == STATUS_PLANTA && seg->start_col == 5) {
-            still_has_plant_5 = 1;
-        }
-        seg = seg->next;
+    int en_rueda = 0;
+    for (Planta* q = *slot; q != NULL; q = q->rueda_sig) {
+        if (q == p) en_rueda = 1;
     }
-    
-    if (found_fused_vacio && still_has_plant_5) {
-        printf("✓ TEST 3 PASADO: Fusion de segmentos vacios adyacentes (Triple Fusión)\n");
+    for (int t = 0; t < 2 * RUEDA_PLANTAS; t++) {
+        gameBoardUpdate(board);
+    }
+    if (!en_rueda) {
+        printf("✓ TEST 3 PASADO: Sacar la planta la saca de la rueda\n");
     } else {
-        printf("✗ TEST 3 FALLADO: No fusiono correctamente segmentos vacios\n");
+        printf("✗ TEST 3 FALLADO: La planta sacada sigue en la rueda\n");
     }
 
-    // TEST 4: Pruebo la Consigna 3 (Llenar fila y sacar del medio).
-    // Esto prueba que se crea un hueco (VACIO, length=1) aislado entre Plantas.
-    resetRow(&board->rows[1]);
-    for (int c = 0; c < GRID_COLS; c++) {
-        gameBoardAddPlant(board, 1, c);
+    gameBoardDelete(board);
+    printf("========================================\n");
+    printf("Tests completados para rueda de plantas\n");
+    printf("========================================\n\n");
+}
+
+
+
+// ========== TESTS gameBoardLoadWaves ==========
+
+
+/**
+ * Pruebas para la línea de tiempo de oleadas.
+ * La idea es validar que el archivo se compile ordenado por tick (estable),
+ * que una línea inválida no cambie nada y que cada oleada spawnee en su
+ * tick, en su fila y con su cantidad, sin spawn aleatorio.
+ */
+void testGameBoardLoadWaves() {
+    printf("\n========= TESTS gameBoardLoadWaves =========\n");
+
+    GameBoard* board = gameBoardNew();
+    if (board == NULL) {
+        printf("✗ Error al crear tablero para tests\n");
+        return;
     }
-    gameBoardRemovePlant(board, 1, 4); // Saco la del medio
-    
-    seg = board->rows[1].first_segment;
-    int plant_count = 0;
-    int has_vacio_at_4 = 0;
-    while (seg != NULL) {
-        if (seg->status == STATUS_PLANTA) plant_count++;
-        if (seg->status == STATUS_VACIO && seg->start_col == 4 && seg->length == 1) {
-            has_vacio_at_4 = 1;
+
+    // TEST 0: Pruebo la robustez ante NULL y archivos que no existen
+    if (gameBoardLoadWaves(NULL, "x") == 0 && gameBoardLoadWaves(board, NULL) == 0 &&
+        gameBoardLoadWaves(board, "no_existe_oleadas.txt") == 0 && !board->oleadas_cargadas) {
+        printf("✓ TEST 0 PASADO: NULL y archivo inexistente no cargan nada\n");
+    } else {
+        printf("✗ TEST 0 FALLADO: Error con parametros invalidos\n");
+    }
+
+    // TEST 1: Pruebo que una línea inválida no cambie nada
+    if (cargarOleadasDeTexto(board, "10 0 1 normal\n20 7 1 normal\n") == 0 &&
+        cargarOleadasDeTexto(board, "10 0 1 gigante\n") == 0 &&
+        cargarOleadasDeTexto(board, "1 1 1000 normal 100\n") == 0 &&   // Demasiado larga
+        cargarOleadasDeTexto(board, "1 1 2 normal 30 basura\n") == 0 && // Campos de más
+        cargarOleadasDeTexto(board, "5 1 1 normal xx\n") == 0 &&        // Espaciado mal escrito
+        cargarOleadasDeTexto(board, "5 1 1 normal 3x\n") == 0 &&
+        !board->oleadas_cargadas && board->cant_oleadas == 0) {
+        printf("✓ TEST 1 PASADO: Archivo invalido rechazado\n");
+    } else {
+        printf("✗ TEST 1 FALLADO: Se cargo un archivo invalido\n");
+    }
+
+    // TEST 2: Pruebo el orden por tick, estable entre oleadas del mismo tick
+    int cargado = cargarOleadasDeTexto(board,
+        "# tick fila cantidad tipo [espaciado]\n"
+        "50 3 4 normal 20\n"
+        "\n"
+        "   10 1 1 normal\n"
+        "50 0 2 normal\n"
+        "30 2 1 normal\n");
+    EventoOleada* ev = board->oleadas;
+    if (cargado == 1 && board->cant_oleadas == 4 &&
+        ev[0].tick == 10 && ev[1].tick == 30 && ev[2].tick == 50 && ev[3].tick == 50 &&
+        ev[2].row == 3 && ev[2].espaciado == 20 && ev[3].row == 0 &&
+        ev[3].espaciado == OLEADA_ESPACIADO) {
+        printf("✓ TEST 2 PASADO: Linea de tiempo ordenada por tick\n");
+    } else {
+        printf("✗ TEST 2 FALLADO: Linea de tiempo mal ordenada\n");
+    }
+
+    // TEST 3: Pruebo que cada oleada spawnee en su tick (y nada más)
+    int spawn_ok = 1;
+    for (int t = 1; t <= ZOMBIE_SPAWN_RATE + 1; t++) {
+        gameBoardUpdate(board);
+        int esperados[GRID_ROWS] = {
+            t >= 50 ? 2 : 0, t >= 10 ? 1 : 0, t >= 30 ? 1 : 0, t >= 50 ? 4 : 0, 0
+        };
+        for (int r = 0; r < GRID_ROWS; r++) {
+            if (board->rows[r].zombies_activos != esperados[r]) spawn_ok = 0;
         }
-        seg = seg->next;
     }
-    
-    if (plant_count == 8 && has_vacio_at_4) {
-        printf("✓ TEST 4 PASADO: Llenar fila y sacar del medio\n");
+    if (spawn_ok && board->proxima_oleada == board->cant_oleadas) {
+        printf("✓ TEST 3 PASADO: Las oleadas spawnean en su tick\n");
     } else {
-        printf("✗ TEST 4 FALLADO: Error al sacar planta de fila llena\n");
+        printf("✗ TEST 3 FALLADO: Spawn de oleadas incorrecto\n");
     }
 
-    // TEST 5: Prueba avanzada: Remover planta aislada (Triple Fusión).
-    // Planto en 4 (VACIO 0-3, PLANTA 4, VACIO 5-8).
-    // Al remover 4, los 3 segmentos deben fusionarse en uno solo (VACIO 0-8).
-    resetRow(&board->rows[2]);
-    gameBoardAddPlant(board, 2, 4);
-    gameBoardRemovePlant(board, 2, 4);
-    
-    seg = board->rows[2].first_segment;
-    if (seg != NULL && seg->status == STATUS_VACIO && seg->start_col == 0 && 
-        seg->length == GRID_COLS && seg->next == NULL) {
-        printf("✓ TEST 5 PASADO: Remover planta aislada (triple fusion)\n");
+    // TEST 4: Pruebo que un tick que desborda al sumarle el del board se
+    // rechace (el board ya no está en el tick 0)
+    int cant_antes = board->cant_oleadas;
+    if (cargarOleadasDeTexto(board, "2147483647 0 1 normal\n") == 0 &&
+        board->cant_oleadas == cant_antes) {
+        printf("✓ TEST 4 PASADO: Tick que desborda rechazado\n");
     } else {
-        printf("✗ TEST 5 FALLADO: No fusiono correctamente en fila vacia\n");
+        printf("✗ TEST 4 FALLADO: Se cargo un tick que desborda\n");
     }
 
-    // TEST 6: Prueba avanzada: Fusión al inicio.
-    // Planto en 0 (PLANTA 0, VACIO 1-8).
-    // Al remover 0, debe fusionarse con el segmento 'next' y quedar (VACIO 0-8).
-    resetRow(&board->rows[2]);
+    // TEST 5: Pruebo líneas más largas que el buffer: un comentario largo
+    // y espacios al final se aceptan enteros (el resto no se lee como
+    // otra línea), basura al final de una oleada larga no
+    char largo[1200];
+    int n = 0;
+    largo[n++] = '#';
+    for (int i = 0; i < 400; i++) largo[n++] = 'x';
+    largo[n++] = '\n';
+    const char* oleada = "7 2 1 normal";
+    for (int i = 0; oleada[i] != '\0'; i++) largo[n++] = oleada[i];
+    for (int i = 0; i < 400; i++) largo[n++] = ' ';
+    largo[n++] = '\n';
+    largo[n] = '\0';
+    int largas_ok = cargarOleadasDeTexto(board, largo) == 1 && board->cant_oleadas == 1 &&
+                    board->oleadas[0].row == 2;
+    n -= 2;
+    largo[n++] = '9';
+    largo[n++] = '\n';
+    largo[n] = '\0';
+    largas_ok = largas_ok && cargarOleadasDeTexto(board, largo) == 0 && board->cant_oleadas == 1;
+    if (largas_ok) {
+        printf("✓ TEST 5 PASADO: Lineas largas leidas enteras\n");
+    } else {
+        printf("✗ TEST 5 FALLADO: Lineas largas mal leidas\n");
+    }
+
+    gameBoardDelete(board);
+    printf("========================================\n");
+    printf("Tests completados para gameBoardLoadWaves\n");
+    printf("========================================\n\n");
+}
+
+
+
+// ========== TESTS FILAS ACTIVAS ==========
+
+
+/**
+ * Pruebas para las máscaras de filas activas.
+ * La idea es validar que cada bit se prenda cuando la fila recibe su
+ * primera planta, zombie o arveja, y se apague cuando se va la última.
+ */
+void testFilasActivas() {
+    printf("\n========= TESTS filas activas =========\n");
+
+    GameBoard* board = gameBoardNew();
+    if (board == NULL) {
+        printf("✗ Error al crear tablero para tests\n");
+        return;
+    }
+
+    // TEST 1: Pruebo la máscara de plantas al agregar y sacar
     gameBoardAddPlant(board, 2, 0);
+    gameBoardAddPlant(board, 2, 3);
+    int con_plantas = (board->filas_con_plantas == (1 << 2));
     gameBoardRemovePlant(board, 2, 0);
-    
-    seg = board->rows[2].first_segment;
-    if (seg != NULL && seg->status == STATUS_VACIO && seg->start_col == 0 && 
-        seg->length == GRID_COLS && seg->next == NULL) {
-        printf("✓ TEST 6 PASADO: Remover al inicio y fusionar\n");
+    int sigue = (board->filas_con_plantas == (1 << 2));
+    gameBoardRemovePlant(board, 2, 3);
+    if (con_plantas && sigue && board->filas_con_plantas == 0) {
+        printf("✓ TEST 1 PASADO: La fila se apaga al sacar su última planta\n");
     } else {
-        printf("✗ TEST 6 FALLADO: No fusiono al remover del inicio\n");
+        printf("✗ TEST 1 FALLADO: Mascara de plantas 0x%x\n", board->filas_con_plantas);
     }
 
-    // TEST 7: Prueba avanzada: Fusión al final.
-    // Planto en 8 (VACIO 0-7, PLANTA 8).
-    // Al remover 8, debe fusionarse con el segmento 'prev' y quedar (VACIO 0-8).
-    resetRow(&board->rows[3]);
-    gameBoardAddPlant(board, 3, 8);
-    gameBoardRemovePlant(board, 3, 8);
-    
-    seg = board->rows[3].first_segment;
-    if (seg != NULL && seg->status == STATUS_VACIO && seg->start_col == 0 && 
-        seg->length == GRID_COLS && seg->next == NULL) {
-        printf("✓ TEST 7 PASADO: Remover al final y fusionar\n");
+    // TEST 2: Pruebo la máscara de zombies al agregar y matar
+    gameBoardAddZombies(board, 1, 2, 10);
+    int con_zombies = (board->filas_con_zombies == (1 << 1));
+    removeZombieNode(board, 1, board->rows[1].front_zombie);
+    sigue = (board->filas_con_zombies == (1 << 1));
+    removeZombieNode(board, 1, board->rows[1].front_zombie);
+    if (con_zombies && sigue && board->filas_con_zombies == 0) {
+        printf("✓ TEST 2 PASADO: La fila se apaga al morir su último zombie\n");
     } else {
-        printf("✗ TEST 7 FALLADO: No fusiono al remover del final\n");
+        printf("✗ TEST 2 FALLADO: Mascara de zombies 0x%x\n", board->filas_con_zombies);
     }
 
-    // TEST 8: Prueba avanzada: Fusiones múltiples complejas.
-    resetRow(&board->rows[4]);
-    // Dejo huecos en columnas impares
-    for (int c = 0; c < GRID_COLS; c += 2) {
-        gameBoardAddPlant(board, 4, c);
+    // TEST 3: Pruebo la máscara de arvejas: una planta dispara a un zombie
+    // hasta que la arveja desaparece (por golpe o por salir de pantalla)
+    gameBoardAddPlant(board, 4, 0);
+    gameBoardAddZombie(board, 4);
+    int prendida = 0;
+    int coherente = 1;
+    for (int t = 0; t < 2000; t++) {
+        gameBoardUpdate(board);
+        for (int r = 0; r < GRID_ROWS; r++) {
+            int bit = (board->filas_con_arvejas >> r) & 1;
+            if (bit != (board->rows[r].cant_arvejas > 0)) coherente = 0;
+            bit = (board->filas_con_zombies >> r) & 1;
+            if (bit != (board->rows[r].zombies_activos > 0)) coherente = 0;
+        }
+        if (board->filas_con_arvejas & (1 << 4)) prendida = 1;
     }
-    // Remuevo plantas para forzar fusiones
-    gameBoardRemovePlant(board, 4, 0);  // Fusiona con [VACIO 1]
-    gameBoardRemovePlant(board, 4, 2);  // Fusiona [VACIO 0-1] con [VACIO 2] y [VACIO 3]
-    
-    seg = board->rows[4].first_segment;
-    int found_large_vacio = 0;
-    while (seg != NULL) {
-        if (seg->status == STATUS_VACIO && seg->start_col == 0 && seg->length == 4) {
-            found_large_vacio = 1; // Debería existir un [VACIO 0-3]
+    if (prendida && coherente) {
+        printf("✓ TEST 3 PASADO: Las mascaras siguen a las filas durante el juego\n");
+    } else {
+        printf("✗ TEST 3 FALLADO: Mascaras desincronizadas\n");
+    }
+
+    gameBoardDelete(board);
+    printf("========================================\n");
+    printf("Tests completados para filas activas\n");
+    printf("========================================\n\n");
+}
+
+
+
+// ========== TESTS gameBoardAdvance ==========
+
+
+/**
+ * Arma el mismo tablero de prueba (con la misma semilla, para que las
+ * plantas y los spawns aleatorios sean iguales).
+ */
+static GameBoard* tableroDeAvance(int eventos) {
+    srand(11);
+    GameBoard* board = gameBoardNew();
+    if (board == NULL) {
+        return NULL;
+    }
+    gameBoardSetModoEventos(board, eventos);
+    gameBoardAddPlant(board, 0, 0);
+    gameBoardAddPlant(board, 0, 2);
+    gameBoardAddPlant(board, 2, 1);
+    gameBoardAddPlant(board, 4, 3);
+    gameBoardAddZombies(board, 0, 6, 20);
+    gameBoardAddZombies(board, 2, 3, 40);
+    return board;
+}
+
+/**
+ * Pruebas para gameBoardAdvance.
+ * La idea es validar que saltar los ticks tranquilos dé exactamente lo
+ * mismo que llamar a gameBoardUpdate tick a tick (en los dos modos de
+ * colisión), y que se frene cuando el juego termina.
+ */
+void testGameBoardAdvance() {
+    printf("\n========= TESTS gameBoardAdvance =========\n");
+
+    // TEST 1: Parámetros inválidos
+    GameBoard* board = gameBoardNew();
+    if (board == NULL) {
+        printf("✗ Error al crear tablero para tests\n");
+        return;
+    }
+    if (gameBoardAdvance(NULL, 10) == 0 && gameBoardAdvance(board, -1) == 0 &&
+        gameBoardAdvance(board, 0) == 0 && board->tick == 0) {
+        printf("✓ TEST 1 PASADO: Parametros invalidos no avanzan el juego\n");
+    } else {
+        printf("✗ TEST 1 FALLADO: Avanzo con parametros invalidos\n");
+    }
+    gameBoardDelete(board);
+
+    // TEST 2 y 3: Avance rápido contra tick a tick, sin y con modo eventos
+    for (int eventos = 0; eventos <= 1; eventos++) {
+        GameBoard* control = tableroDeAvance(eventos);
+        int iguales = 1;
+        int ticks = 0;
+        for (int paso = 0; paso < 8 && control != NULL; paso++) {
+            for (int t = 0; t < 250; t++) {
+                gameBoardUpdate(control);
+            }
+            ticks += 250;
         }
-        seg = seg->next;
+        board = tableroDeAvance(eventos);
+        int avanzados = 0;
+        for (int paso = 0; paso < 8 && board != NULL; paso++) {
+            avanzados += gameBoardAdvance(board, 250);
+        }
+        if (control == NULL || board == NULL || avanzados != ticks || !mismoEstado(board, control)) {
+            iguales = 0;
+        }
+        if (iguales) {
+            printf("✓ TEST %d PASADO: Avanzar %d ticks da lo mismo que tick a tick%s\n",
+                   2 + eventos, ticks, eventos ? " (modo eventos)" : "");
+        } else {
+            printf("✗ TEST %d FALLADO: El avance rapido no coincide%s\n",
+                   2 + eventos, eventos ? " (modo eventos)" : "");
+        }
+        gameBoardDelete(board);
+        gameBoardDelete(control);
     }
-    
-    if (found_large_vacio) {
-        printf("✓ TEST 8 PASADO: Fusiones multiples complejas\n");
+
+    // TEST 4: Se frena en el tick en el que un zombie llega a la casa
+    GameBoard* control = gameBoardNew();
+    board = gameBoardNew();
+    if (board == NULL || control == NULL) {
+        printf("✗ Error al crear tablero para tests\n");
+        gameBoardDelete(board);
+        gameBoardDelete(control);
+        srand(time(NULL));
+        return;
+    }
+    cargarOleadasDeTexto(board, "0 3 1 normal\n");
+    cargarOleadasDeTexto(control, "0 3 1 normal\n");
+    int ticks_control = 0;
+    while (!gameBoardIsGameOver(control) && ticks_control < 100000) {
+        gameBoardUpdate(control);
+        ticks_control++;
+    }
+    int ticks_avance = gameBoardAdvance(board, 100000);
+    if (gameBoardIsGameOver(board) && ticks_avance == ticks_control && mismoEstado(board, control)) {
+        printf("✓ TEST 4 PASADO: El avance se frena al terminar el juego (tick %d)\n", ticks_avance);
     } else {
-        printf("✗ TEST 8 FALLADO: No manejo fusiones complejas\n");
+        printf("✗ TEST 4 FALLADO: Frenó en %d ticks, tick a tick en %d\n", ticks_avance, ticks_control);
     }
 
-    // TEST 9: Stress test: Llenar y vaciar la fila.
-    // Esto asegura que la lógica de fusión es robusta y puede
-    // devolver la fila a su estado inicial (1 solo segmento VACIO).
-    resetRow(&board->rows[4]);
-    for (int c = 0; c < GRID_COLS; c++) {
-        gameBoardAddPlant(board, 4, c);
+    gameBoardDelete(board);
+    gameBoardDelete(control);
+
+    // TEST 5: Una planta con alcance sin zombies en rango no corta los
+    // saltos: espera en la rueda hasta el tick en que el zombie entra
+    control = gameBoardNew();
+    board = gameBoardNew();
+    if (board == NULL || control == NULL) {
+        printf("✗ Error al crear tablero para tests\n");
+        gameBoardDelete(board);
+        gameBoardDelete(control);
+        srand(time(NULL));
+        return;
     }
-    for (int c = GRID_COLS - 1; c >= 0; c--) { // Vacio de derecha a izquierda
-        gameBoardRemovePlant(board, 4, c);
+    GameBoard* tableros[2] = {board, control};
+    for (int b = 0; b < 2; b++) {
+        cargarOleadasDeTexto(tableros[b], "0 1 1 normal\n");
+        srand(3);
+        gameBoardAddPlant(tableros[b], 1, 0);
+        gameBoardSetPlantRange(tableros[b], 1, 0, CELL_WIDTH);
     }
-    
-    seg = board->rows[4].first_segment;
-    if (seg != NULL && seg->status == STATUS_VACIO && seg->start_col == 0 && 
-        seg->length == GRID_COLS && seg->next == NULL) {
-        printf("✓ TEST 9 PASADO: Stress test - volver a fila vacia\n");
+    gameBoardAdvance(board, 300);
+    for (int t = 0; t < 300; t++) {
+        gameBoardUpdate(control);
+    }
+    int salto = ticksTranquilos(board, 1000, 1);
+    int iguales = mismoEstado(board, control);
+    gameBoardAdvance(board, 2000);
+    for (int t = 0; t < 2000; t++) {
+        gameBoardUpdate(control);
+    }
+    if (salto > 100 && iguales && mismoEstado(board, control)) {
+        printf("✓ TEST 5 PASADO: La planta con alcance no frena el avance (salto de %d ticks)\n", salto);
     } else {
-        printf("✗ TEST 9 FALLADO: No volvio a estado inicial\n");
+        printf("✗ TEST 5 FALLADO: Salto de %d ticks con una planta con alcance\n", salto);
     }
 
     gameBoardDelete(board);
+    gameBoardDelete(control);
+    srand(time(NULL));
     printf("========================================\n");
-    printf("Tests completados para gameBoardRemovePlant\n");
+    printf("Tests completados para gameBoardAdvance\n");
     printf("========================================\n\n");
 }
 
 
 
+// ========== TESTS gameBoardSetHilos ==========
 
 
+static int* tramosHechos = NULL; // Para el TEST 5: veces que se hizo cada elemento
 
-// ========== TESTS gameBoardAddZombie ==========
-
+/**
+ * Trabajo de prueba: marca cada elemento del tramo como hecho.
+ */
+static void marcarTramo(GameBoard* board, int fila, int desde, int hasta) {
+    for (int k = desde; k < hasta; k++) {
+        tramosHechos[k]++;
+    }
+}
 
 /**
- * Pruebas para gameBoardAddZombie.
- * La idea es validar que la inserción en la lista de zombies
- * funcione, cumpla con los casos de la consigna (escalabilidad)
- * y que los datos se inicialicen correctamente.
+ * Pruebas para el update repartido entre hilos (pool con robo de trabajo).
+ * La idea es validar que con hilos el juego dé exactamente lo mismo que
+ * con uno solo (también con una fila mucho más cargada que las otras),
+ * que se pueda volver a un solo hilo, y que el parallel-for haga cada
+ * tramo una sola vez.
  */
-void testGameBoardAddZombie() {
-    printf("\n========= TESTS gameBoardAddZombie =========\n");
-    
-    // TEST 0: Pruebo la robustez de la función ante inputs inválidos.
+void testGameBoardSetHilos() {
+    printf("\n========= TESTS gameBoardSetHilos =========\n");
+
+    // TEST 1: Parámetros inválidos
     GameBoard* board = gameBoardNew();
     if (board == NULL) {
         printf("✗ Error al crear tablero para tests\n");
         return;
     }
-    
-    // Pruebo con board NULL y filas fuera de rango
-    gameBoardAddZombie(NULL, 0);
-    gameBoardAddZombie(board, -1);
-    gameBoardAddZombie(board, GRID_ROWS);
-    
-    // Verifico que la lista siga vacía
-    int all_empty = 1;
-    for (int i = 0; i < GRID_ROWS; i++) {
-        if (board->rows[i].first_zombie != NULL) {
-            all_empty = 0;
-            break;
-        }
-    }
-    
-    if (all_empty) {
-        printf("✓ TEST 0 PASADO: Maneja inputs invalidos sin agregar zombies\n");
+    if (gameBoardSetHilos(NULL, 2) == 0 && gameBoardSetHilos(board, 0) == 0 &&
+        board->pool == NULL) {
+        printf("✓ TEST 1 PASADO: Parametros invalidos no crean hilos\n");
     } else {
-        printf("✗ TEST 0 FALLADO: Agrego zombie con input invalido\n");
+        printf("✗ TEST 1 FALLADO: Se aceptaron parametros invalidos\n");
     }
-    
-    // TEST 1: Pruebo la Consigna 1 (Agregar a lista existente).
-    // Agrego 3 zombies y cuento. Luego agrego 1 más y vuelvo a contar.
-    int test_row = 2;
-    for (int i = 0; i < 3; i++) {
-        gameBoardAddZombie(board, test_row);
+    gameBoardDelete(board);
+
+    // TEST 2: Con 4 hilos da lo mismo que con uno
+    GameBoard* control = tableroDeAvance(0);
+    board = tableroDeAvance(0);
+    if (board == NULL || control == NULL || !gameBoardSetHilos(board, 4)) {
+        printf("✗ Error al crear tablero para tests\n");
+        gameBoardDelete(board);
+        gameBoardDelete(control);
+        srand(time(NULL));
+        return;
     }
-    
-    int count = 0;
-    ZombieNode* current = board->rows[test_row].first_zombie;
-    while (current != NULL) {
-        count++;
-        current = current->next;
+    int iguales = 1;
+    for (int t = 0; t < 2000 && iguales; t++) {
+        // Los dos boards consumen rand() igual si arrancan con la misma semilla
+        srand(t);
+        gameBoardUpdate(control);
+        srand(t);
+        gameBoardUpdate(board);
+        iguales = mismoEstado(board, control) && board->cant_golpes == control->cant_golpes;
     }
-    
-    if (count == 3) {
-        gameBoardAddZombie(board, test_row); // Agrego el cuarto
-        
-        count = 0;
-        current = board->rows[test_row].first_zombie;
-        while (current != NULL) {
-            count++;
-            current = current->next;
-        }
-        
-        if (count == 4) {
-            printf("✓ TEST 1 PASADO: Tomar lista de 3 zombies y agregar 1 mas\n");
-        } else {
-            printf("✗ TEST 1 FALLADO: Esperados 4, encontrados %d\n", count);
+    if (iguales) {
+        printf("✓ TEST 2 PASADO: El update con hilos coincide con el de un hilo\n");
+    } else {
+        printf("✗ TEST 2 FALLADO: El update con hilos se desvio en el tick %d\n", board->tick);
+    }
+
+    // TEST 3: Vuelvo a un solo hilo y sigue igual
+    if (gameBoardSetHilos(board, 1) && board->pool == NULL) {
+        for (int t = 0; t < 200; t++) {
+            srand(t);
+            gameBoardUpdate(control);
+            srand(t);
+            gameBoardUpdate(board);
         }
+    }
+    if (board->pool == NULL && mismoEstado(board, control)) {
+        printf("✓ TEST 3 PASADO: Se puede volver a un solo hilo\n");
     } else {
-        printf("✗ TEST 1 FALLADO: No se crearon los 3 zombies iniciales\n");
+        printf("✗ TEST 3 FALLADO: No se cerro el pool o se desvio el juego\n");
     }
-    
-    // TEST 2: Pruebo la Consigna 2 (Test de escalabilidad).
-    // La idea es verificar que la lista enlazada puede crecer
-    // mucho más que un array estático, probando con 10000 nodos.
-    printf("TEST 2: Creando 10000 zombies (puede tomar un momento)...\n");
-    
+
     gameBoardDelete(board);
-    board = gameBoardNew();
-    if (board == NULL) {
-        printf("✗ Error al recrear tablero\n");
+    gameBoardDelete(control);
+
+    // TEST 4: Fila muy cargada: los zombies de una sola fila se reparten
+    // en muchos tramos y el resultado sigue siendo el mismo
+    control = tableroDeAvance(0);
+    board = tableroDeAvance(0);
+    if (board == NULL || control == NULL || !gameBoardSetHilos(board, 4)) {
+        printf("✗ Error al crear tablero para tests\n");
+        gameBoardDelete(board);
+        gameBoardDelete(control);
+        srand(time(NULL));
         return;
     }
-    
-    int large_count = 10000;
-    int row_test = 1;
-    
-    for (int i = 0; i < large_count; i++) {
-        gameBoardAddZombie(board, row_test);
+    gameBoardAddZombies(control, 1, 20 * TRAMO_ZOMBIES, 1);
+    gameBoardAddZombies(board, 1, 20 * TRAMO_ZOMBIES, 1);
+    srand(5); // El cooldown inicial de la planta sale de rand()
+    gameBoardAddPlant(control, 1, 0);
+    srand(5);
+    gameBoardAddPlant(board, 1, 0);
+    iguales = 1;
+    for (int t = 0; t < 600 && iguales; t++) {
+        srand(t);
+        gameBoardUpdate(control);
+        srand(t);
+        gameBoardUpdate(board);
+        iguales = mismoEstado(board, control);
     }
-    
-    // Cuento los zombies agregados
-    count = 0;
-    current = board->rows[row_test].first_zombie;
-    while (current != NULL && count <= large_count) {
-        count++;
-        current = current->next;
+    if (iguales) {
+        printf("✓ TEST 4 PASADO: Una fila con %d zombies da lo mismo con hilos\n", 20 * TRAMO_ZOMBIES);
+    } else {
+        printf("✗ TEST 4 FALLADO: La fila cargada se desvio en el tick %d\n", board->tick);
     }
-    
-    if (count == large_count) {
-        printf("✓ TEST 2 PASADO: Crear lista de 10000 zombies\n");
+
+    // TEST 5: Cada tramo del parallel-for se hace exactamente una vez
+    int cantidad = 50 * TRAMO_ARVEJAS + 7;
+    tramosHechos = (int*)calloc(cantidad, sizeof(int));
+    int una_vez = (tramosHechos != NULL);
+    if (una_vez) {
+        paraleloPorTramos(board, marcarTramo, 0, cantidad, TRAMO_ARVEJAS);
+        esperarTrabajos(board);
+        for (int k = 0; k < cantidad; k++) {
+            if (tramosHechos[k] != 1) una_vez = 0;
+        }
+    }
+    if (una_vez && SDL_AtomicGet(&board->pool->pendientes) == 0) {
+        printf("✓ TEST 5 PASADO: Todos los tramos se hicieron una vez\n");
     } else {
-        printf("✗ TEST 2 FALLADO: Esperados %d, encontrados %d\n", large_count, count);
+        printf("✗ TEST 5 FALLADO: Hay tramos sin hacer o repetidos\n");
     }
-    
-    // TEST 3: Prueba avanzada: Verifico la inicialización de datos.
-    // Me aseguro que un zombie nuevo tenga los valores correctos
-    // (vida, posición, estado, etc.).
+    free(tramosHechos);
+    tramosHechos = NULL;
+
     gameBoardDelete(board);
-    board = gameBoardNew();
+    gameBoardDelete(control);
+    srand(time(NULL));
+    printf("========================================\n");
+    printf("Tests completados para gameBoardSetHilos\n");
+    printf("========================================\n\n");
+}
+
+
+
+// ========== TESTS gameBoardPushCommand ==========
+
+
+#define COMANDOS_DEL_PRODUCTOR 5000 // Para el TEST 4
+
+/**
+ * Productor del TEST 4: manda zombies a la fila 3 desde otro hilo,
+ * reintentando cuando la cola está llena.
+ */
+static int productorDeComandos(void* datos) {
+    GameBoard* board = (GameBoard*)datos;
+    for (int i = 0; i < COMANDOS_DEL_PRODUCTOR; i++) {
+        while (!gameBoardPushCommand(board, COMANDO_ZOMBIE, 3, 0)) {
+            SDL_Delay(0);
+        }
+    }
+    return 0;
+}
+
+/**
+ * Pruebas para la cola de comandos del input.
+ * La idea es validar que los comandos se apliquen recién al empezar el
+ * tick y en orden, que la cola avise cuando está llena, y que un
+ * productor en otro hilo no pierda ni repita comandos.
+ */
+void testGameBoardPushCommand() {
+    printf("\n========= TESTS gameBoardPushCommand =========\n");
+
+    GameBoard* board = gameBoardNew();
     if (board == NULL) {
-        printf("✗ Error al recrear tablero\n");
+        printf("✗ Error al crear tablero para tests\n");
         return;
     }
-    
-    gameBoardAddZombie(board, 0);
-    ZombieNode* zombie = board->rows[0].first_zombie;
-    
-    if (zombie != NULL) {
-        int init_ok = 1;
-        if (zombie->zombie_data.vida != 100) init_ok = 0;
-        if (zombie->zombie_data.activo != 1) init_ok = 0;
-        if (zombie->zombie_data.row != 0) init_ok = 0;
-        if (zombie->zombie_data.pos_x != SCREEN_WIDTH) init_ok = 0;
-        
-        if (init_ok) {
-            printf("✓ TEST 3 PASADO: Zombie inicializado correctamente\n");
-        } else {
-            printf("✗ TEST 3 FALLADO: Inicializacion incorrecta\n");
-        }
+    cargarOleadasDeTexto(board, ""); // Sin spawn aleatorio: solo los zombies pedidos
+
+    // TEST 1: Parámetros inválidos
+    if (gameBoardPushCommand(NULL, COMANDO_PLANTAR, 0, 0) == 0 &&
+        gameBoardPushCommand(board, 99, 0, 0) == 0 &&
+        SDL_AtomicGet(&board->comandos.escritos) == 0) {
+        printf("✓ TEST 1 PASADO: Comandos invalidos no se encolan\n");
     } else {
-        printf("✗ TEST 3 FALLADO: No se creo el zombie\n");
+        printf("✗ TEST 1 FALLADO: Se encolo un comando invalido\n");
     }
-    
-    // TEST 4: Prueba avanzada: Verifico la independencia de las filas.
-    // Agrego zombies en distintas filas y me aseguro que no se mezclen.
-    gameBoardDelete(board);
-    board = gameBoardNew();
-    if (board == NULL) {
-        printf("✗ Error al recrear tablero\n");
-        return;
+
+    // TEST 2: Se aplican al empezar el tick, en orden
+    gameBoardPushCommand(board, COMANDO_PLANTAR, 2, 4);
+    gameBoardPushCommand(board, COMANDO_PLANTAR, 2, 6);
+    gameBoardPushCommand(board, COMANDO_SACAR_PLANTA, 2, 4);
+    gameBoardPushCommand(board, COMANDO_ZOMBIE, 1, 0);
+    int antes = (board->rows[2].cant_plantas == 0 && board->rows[1].zombies_activos == 0);
+    gameBoardUpdate(board);
+    if (antes && board->rows[2].cant_plantas == 1 && board->rows[1].zombies_activos == 1 &&
+        SDL_AtomicGet(&board->comandos.leidos) == 4) {
+        printf("✓ TEST 2 PASADO: Los comandos se aplican en orden al empezar el tick\n");
+    } else {
+        printf("✗ TEST 2 FALLADO: Plantas %d, zombies %d\n",
+               board->rows[2].cant_plantas, board->rows[1].zombies_activos);
     }
-    
-    gameBoardAddZombie(board, 0);
-    gameBoardAddZombie(board, 2);
-    gameBoardAddZombie(board, 4);
-    
-    int test4_ok = 1;
-    for (int i = 0; i < GRID_ROWS; i++) {
-        int expected = (i == 0 || i == 2 || i == 4) ? 1 : 0;
-        
-        count = 0;
-        current = board->rows[i].first_zombie;
-        while (current != NULL) {
-            count++;
-            current = current->next;
-        }
-        
-        if (count != expected) test4_ok = 0;
+
+    // TEST 3: La cola llena rechaza comandos hasta el próximo tick
+    int encolados = 0;
+    while (gameBoardPushCommand(board, COMANDO_ZOMBIE, 0, 0)) {
+        encolados++;
     }
-    
-    if (test4_ok) {
-        printf("✓ TEST 4 PASADO: Zombies en filas independientes\n");
+    gameBoardUpdate(board);
+    if (encolados == COLA_COMANDOS && board->rows[0].zombies_activos == COLA_COMANDOS &&
+        gameBoardPushCommand(board, COMANDO_ZOMBIE, 0, 0)) {
+        printf("✓ TEST 3 PASADO: La cola se llena con %d comandos y se vacia en el tick\n", encolados);
     } else {
-        printf("✗ TEST 4 FALLADO: Error en distribucion por filas\n");
+        printf("✗ TEST 3 FALLADO: Entraron %d comandos\n", encolados);
     }
-    
-    // TEST 5: Prueba avanzada: Verifico la lógica de inserción (LIFO).
-    // La función debe insertar al *principio* de la lista (head insertion).
-    gameBoardDelete(board);
-    board = gameBoardNew();
-    if (board == NULL) {
-        printf("✗ Error al recrear tablero\n");
-        return;
+    gameBoardUpdate(board);
+
+    // TEST 4: Productor en otro hilo mientras se actualiza el juego
+    SDL_Thread* productor = SDL_CreateThread(productorDeComandos, "input", board);
+    int ticks = 0;
+    while (productor != NULL && board->rows[3].zombies_activos < COMANDOS_DEL_PRODUCTOR &&
+           ticks < 1000000) {
+        gameBoardUpdate(board);
+        ticks++;
     }
-    
-    // Agrego 3 zombies con vidas distintas para identificarlos
-    gameBoardAddZombie(board, 3);
-    board->rows[3].first_zombie->zombie_data.vida = 50;  // 1ro
-    gameBoardAddZombie(board, 3);
-    board->rows[3].first_zombie->zombie_data.vida = 75;  // 2do
-    gameBoardAddZombie(board, 3);
-    board->rows[3].first_zombie->zombie_data.vida = 90;  // 3ro (debe ser el 1ro en la lista)
-    
-    // Verifico el orden: 90 -> 75 -> 50
-    current = board->rows[3].first_zombie;
-    if (current && current->zombie_data.vida == 90 &&
-        current->next && current->next->zombie_data.vida == 75 &&
-        current->next->next && current->next->next->zombie_data.vida == 50) {
-        printf("✓ TEST 5 PASADO: Zombies se agregan al inicio (LIFO)\n");
+    SDL_WaitThread(productor, NULL);
+    gameBoardUpdate(board);
+    if (productor != NULL && board->rows[3].zombies_activos == COMANDOS_DEL_PRODUCTOR) {
+        printf("✓ TEST 4 PASADO: Llegaron los %d comandos del otro hilo\n", COMANDOS_DEL_PRODUCTOR);
     } else {
-        printf("✗ TEST 5 FALLADO: Orden incorrecto en la lista\n");
+        printf("✗ TEST 4 FALLADO: Llegaron %d de %d comandos\n",
+               board->rows[3].zombies_activos, COMANDOS_DEL_PRODUCTOR);
     }
-    
+
     gameBoardDelete(board);
     printf("========================================\n");
-    printf("Tests completados para gameBoardAddZombie\n");
+    printf("Tests completados para gameBoardPushCommand\n");
     printf("========================================\n\n");
 }
 
 
 
-
 SDL_Texture* cargarTextura(const char* path) {
     SDL_Texture* newTexture = IMG_LoadTexture(renderer, path);
     if (newTexture == NULL) printf("No se pudo cargar la textura %s! SDL_image Error: %s\n", path, IMG_GetError());
@@ -1947,6 +5847,11 @@ int main(int argc, char* args[]) {
     // Creo el GameBoard dinámico
     game_board = gameBoardNew();
 
+    // Opcional: archivo de oleadas en lugar del spawn aleatorio
+    if (argc > 1 && game_board != NULL) {
+        gameBoardLoadWaves(game_board, args[1]);
+    }
+
     // --- Ejecución de Tests ---
     // antes de arrancar el juego.
     testStrDuplicate();
@@ -1955,6 +5860,21 @@ int main(int argc, char* args[]) {
     testGameBoardAddZombie();  
     testGameBoardRemovePlant();   
     testGameBoardAddPlant();
+    testGameBoardAddZombies();
+    testZombieHandles();
+    testArvejas();
+    testArvejaTocaZombie();
+    testGameBoardIsGameOver();
+    testModoEventos();
+    testZombiesActivos();
+    testGameBoardNearestZombieAhead();
+    testGameBoardGetHits();
+    testRuedaDePlantas();
+    testGameBoardLoadWaves();
+    testFilasActivas();
+    testGameBoardAdvance();
+    testGameBoardSetHilos();
+    testGameBoardPushCommand();
 
 
     SDL_Event e;
@@ -1978,9 +5898,10 @@ int main(int argc, char* args[]) {
                     cursor.row = (mouse_y - GRID_OFFSET_Y) / CELL_HEIGHT;
                 }
             }
-            // Agrego una planta al hacer click
+            // Agrego una planta al hacer click: el pedido va por la cola de
+            // comandos y la simulación lo aplica al empezar el próximo tick
             if (e.type == SDL_MOUSEBUTTONDOWN) {
-                gameBoardAddPlant(game_board, cursor.row, cursor.col);
+                gameBoardPushCommand(game_board, COMANDO_PLANTAR, cursor.row, cursor.col);
             }
         }
 
@@ -1991,23 +5912,11 @@ int main(int argc, char* args[]) {
         gameBoardDraw(game_board);
 
         // 4. CHEQUEO DE GAME OVER (Consigna)
-        // La idea es replicar la lógica del juego base, pero
-        // iterando sobre las nuevas listas de zombies de cada fila.
-        for (int r = 0; r < GRID_ROWS; r++) {
-            ZombieNode* current = game_board->rows[r].first_zombie;
-            while (current != NULL) {
-                Zombie* z = &current->zombie_data;
-                
-                // La condición es la misma que el juego base:
-                // Si el zombie está activo y su 'x' supera la línea de la casa.
-                if (z->activo && z->rect.x < GRID_OFFSET_X - z->rect.w) {
-                    printf("GAME OVER - Un zombie llego a tu casa!\n");
-                    game_over = 1;
-                    break; // Dejo de chequear zombies en esta fila
-                }
-                current = current->next;
-            }
-            if (game_over) break; // Dejo de chequear las otras filas
+        // El board sabe cuál es el zombie de más adelante de cada fila,
+        // así que alcanza con preguntarle (un valor por fila).
+        if (gameBoardIsGameOver(game_board)) {
+            printf("GAME OVER - Un zombie llego a tu casa!\n");
+            game_over = 1;
         }
 
         // Control de FPS (aprox 60 FPS)
@@ -2015,6 +5924,11 @@ int main(int argc, char* args[]) {
     }
 
     // 5. LIMPIEZA
+    // Informo el máximo de arvejas en vuelo para poder dimensionar la reserva
+    printf("Arvejas: maximo %d en vuelo (capacidad %d, descartadas %d)\n",
+           game_board->arvejas_max_activas, game_board->arvejas_capacidad,
+           game_board->arvejas_descartadas);
+
     // Libero toda la memoria dinámica pedida
     gameBoardDelete(game_board);
     cerrar(); // Libero texturas y cierro SDL